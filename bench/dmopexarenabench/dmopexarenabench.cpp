@@ -0,0 +1,57 @@
+﻿#include "dmopex.h"
+#include "dmopex_arena.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    // One frame: three chained batch operations with two temporaries and one result
+    volatile std::size_t runtime_count = 1 << 12;
+    const std::size_t count = runtime_count;
+    const int frames = 20000;
+
+    std::vector<Vector3D> positions(count, Vector3D{ 1, 2, 3 }), velocities(count, Vector3D{ 0.5f, 0.5f, 0.5f });
+    std::vector<Vector3D> scales(count, Vector3D{ 2, 2, 2 }), offsets(count, Vector3D{ 1, 1, 1 });
+    volatile float sink = 0;
+
+    double vector_ms = measure_ms([&] {
+        for (int frame = 0; frame < frames; ++frame) {
+            std::vector<Vector3D> moved(count), scaled(count), result(count);
+            dmopex::batch_add<Vector3D>(positions, velocities, moved);
+            dmopex::batch_mul<Vector3D>(moved, scales, scaled);
+            dmopex::batch_sub<Vector3D>(scaled, offsets, result);
+            sink = result[count - 1].x;
+        }
+    });
+
+    double arena_ms = measure_ms([&] {
+        dmopex::arena& scratch = dmopex::arena::local();
+        for (int frame = 0; frame < frames; ++frame) {
+            dmopex::span<Vector3D> moved = dmopex::batch_add<Vector3D>(scratch, positions, velocities);
+            dmopex::span<Vector3D> scaled = dmopex::batch_mul<Vector3D>(scratch, moved, scales);
+            dmopex::span<Vector3D> result = dmopex::batch_sub<Vector3D>(scratch, scaled, offsets);
+            sink = result[count - 1].x;
+            scratch.reset();
+        }
+    });
+
+    std::printf("Vector3D x %zu, %d frames of add -> mul -> sub\n", count, frames);
+    std::printf("std::vector temporaries:   %8.2f ms\n", vector_ms);
+    std::printf("dmopex::arena temporaries: %8.2f ms (x%.2f)\n", arena_ms, vector_ms / arena_ms);
+    return 0;
+}
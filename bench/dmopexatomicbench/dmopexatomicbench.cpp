@@ -0,0 +1,80 @@
+﻿#include "dmopex.h"
+#include "dmopex_atomic.h"
+#include "dmopex_sharded.h"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// 16 bytes: whole-struct double-width CAS
+struct Point2D {
+    double x, y;
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+// 32 bytes: one fetch_add per member
+struct SessionStats {
+    std::int64_t bytes_in, bytes_out;
+    std::int64_t requests, errors;
+
+    DEFINE_STRUCT_OPERATORS(SessionStats, bytes_in, bytes_out, requests, errors)
+};
+
+template<typename F>
+double measure_ms(int threads, F f) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(f);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template<typename T>
+void run(const char* name, const T& delta) {
+    const int ops_per_thread = 100000;
+
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        std::mutex mutex;
+        T locked{};
+        double mutex_ms = measure_ms(threads, [&] {
+            for (int i = 0; i < ops_per_thread; ++i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked += delta;
+            }
+        });
+
+        dmopex::atomic<T> shared;
+        double atomic_ms = measure_ms(threads, [&] {
+            for (int i = 0; i < ops_per_thread; ++i) {
+                shared += delta;
+            }
+        });
+
+        dmopex::sharded<T> shards;
+        double sharded_ms = measure_ms(threads, [&] {
+            for (int i = 0; i < ops_per_thread; ++i) {
+                shards += delta;
+            }
+        });
+
+        const double ops = double(threads) * ops_per_thread;
+        std::printf("%-12s %-7s %2d threads | std::mutex %6.1f ns/op | dmopex::atomic %6.1f ns/op (x%.2f) | dmopex::sharded %6.1f ns/op (x%.2f)\n",
+            name, dmopex::atomic<T>::whole_struct ? "whole" : "members", threads,
+            mutex_ms * 1e6 / ops, atomic_ms * 1e6 / ops, mutex_ms / atomic_ms, sharded_ms * 1e6 / ops, mutex_ms / sharded_ms);
+    }
+}
+
+int main() {
+    run("Point2D", Point2D{ 1.0, 0.5 });
+    run("SessionStats", SessionStats{ 512, 128, 1, 0 });
+    return 0;
+}
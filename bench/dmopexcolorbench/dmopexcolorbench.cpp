@@ -0,0 +1,85 @@
+﻿#include "dmopex.h"
+#include "dmopex_color.h"
+#include "dmopex_batch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// int-per-channel color as used before rgba8
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    const std::size_t count = 1 << 22;
+    const int rounds = 20;
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> channel(0, 255);
+    std::vector<Color> colors(count), tints(count), colors_out(count);
+    std::vector<dmopex::rgba8> pixels(count), pixel_tints(count), pixels_out(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        colors[i] = Color{ channel(rng), channel(rng), channel(rng), channel(rng) };
+        tints[i] = Color{ channel(rng), channel(rng), channel(rng), channel(rng) };
+        pixels[i] = dmopex::rgba8{ std::uint8_t(colors[i].r), std::uint8_t(colors[i].g), std::uint8_t(colors[i].b), std::uint8_t(colors[i].a) };
+        pixel_tints[i] = dmopex::rgba8{ std::uint8_t(tints[i].r), std::uint8_t(tints[i].g), std::uint8_t(tints[i].b), std::uint8_t(tints[i].a) };
+    }
+
+    double color_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                colors_out[i] = colors[i] + tints[i];
+            }
+        }
+    });
+
+    double scalar_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                pixels_out[i] = pixels[i] + pixel_tints[i];
+            }
+        }
+    });
+
+    double add_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_add<dmopex::rgba8>(pixels, pixel_tints, pixels_out);
+        }
+    });
+
+    double mul_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_mul<dmopex::rgba8>(pixels, pixel_tints, pixels_out);
+        }
+    });
+
+    double modulate_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_modulate(pixels, pixel_tints, pixels_out);
+        }
+    });
+
+    std::printf("%zu colors x %d rounds\n", count, rounds);
+    auto report = [&](const char* type, const char* op, double ms) {
+        std::printf("%-28s %-16s %8.2f ms (x%.2f)\n", type, op, ms, color_ms / ms);
+    };
+    report("Color (4 x int, 16 bytes)", "operator+", color_ms);
+    report("rgba8 (4 bytes)", "operator+", scalar_ms);
+    report("rgba8", "batch_add", add_ms);
+    report("rgba8", "batch_mul", mul_ms);
+    report("rgba8", "batch_modulate", modulate_ms);
+    std::printf("checksum %d %d\n", colors_out[count / 2].r, int(pixels_out[count / 2].r));
+    return 0;
+}
@@ -0,0 +1,105 @@
+﻿#include "dmopex.h"
+#include "dmopex_column.h"
+#include "dmopex_transpose.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// 32 bytes per particle, the columns below are read with a stride of 8 floats
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    int id;
+
+    DEFINE_STRUCT_OPERATORS(Particle, x, y, z, vx, vy, vz, mass, id)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    // In-cache arrays, count read through a volatile so the loops keep a runtime trip count
+    volatile std::size_t runtime_count = 1 << 13;
+    const std::size_t count = runtime_count;
+    const int rounds = 20000;
+
+    std::vector<Particle> particles(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i % 97);
+        particles[i] = Particle{ f, -f, 2.0f * f, 0.5f, 0.25f, -0.5f, 1.0f + f, static_cast<int>(i) };
+    }
+    volatile float sink = 0;
+
+    double sum_by_hand_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            float sum = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += particles[i].mass;
+            }
+            sink = sum;
+        }
+    });
+
+    double sum_of_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            sink = dmopex::sum_of(dmopex::column<&Particle::mass>(particles));
+        }
+    });
+
+    std::vector<float> xs(count), ys(count), zs(count), vxs(count), vys(count), vzs(count), masses(count);
+    std::vector<int> ids(count);
+    double transposed_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::aos_to_soa<Particle>(particles, { xs.data(), ys.data(), zs.data(), vxs.data(), vys.data(), vzs.data(), masses.data(), ids.data() });
+            sink = dmopex::sum_of(dmopex::column_view<const float>(masses));
+        }
+    });
+
+    double min_by_hand_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            float lowest = particles[0].x;
+            for (std::size_t i = 1; i < count; ++i) {
+                lowest = particles[i].x < lowest ? particles[i].x : lowest;
+            }
+            sink = lowest;
+        }
+    });
+
+    double min_of_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            sink = dmopex::min_of(dmopex::column<&Particle::x>(particles));
+        }
+    });
+
+    double add_by_hand_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                particles[i].x += particles[i].vx;
+            }
+        }
+    });
+
+    double batch_add_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            auto x = dmopex::column<&Particle::x>(particles);
+            dmopex::batch_add(x, dmopex::column<&Particle::vx>(particles), x);
+        }
+    });
+
+    std::printf("Particle (32 bytes) x %zu, %d rounds\n", count, rounds);
+    std::printf("sum of mass by hand:            %8.2f ms\n", sum_by_hand_ms);
+    std::printf("dmopex::sum_of(column):         %8.2f ms\n", sum_of_ms);
+    std::printf("aos_to_soa then sum_of:         %8.2f ms\n", transposed_ms);
+    std::printf("min of x by hand:               %8.2f ms\n", min_by_hand_ms);
+    std::printf("dmopex::min_of(column):         %8.2f ms\n", min_of_ms);
+    std::printf("x += vx by hand:                %8.2f ms\n", add_by_hand_ms);
+    std::printf("dmopex::batch_add(columns):     %8.2f ms\n", batch_add_ms);
+    return 0;
+}
@@ -0,0 +1,84 @@
+﻿// Compile time of a translation unit with many types, under the C++17 (enable_if) and C++20 (concept)
+// forms of the non-intrusive operators. Every configuration is compiled with -fsyntax-only; the
+// compiler is taken from $CXX (default c++). Usage: dmopexcompilebench [types] [rounds]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+    std::string include_dir() {
+        std::string file = __FILE__;
+        std::string::size_type pos = file.find_last_of("/\\");
+        pos = file.find_last_of("/\\", pos - 1);
+        pos = file.find_last_of("/\\", pos - 1);
+        return (pos == std::string::npos ? std::string(".") : file.substr(0, pos)) + "/include";
+    }
+
+    enum class unit { header, unrelated, declared, registered };
+
+    // header:     the header alone
+    // unrelated:  types with their own operators, looked up next to the generic templates
+    // declared:   types registered with DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE but never used
+    // registered: the same types, each used with +, == and <<
+    void write_unit(const std::string& path, unit kind, int types) {
+        std::ofstream out(path);
+        out << "#include \"dmopex_non_intrusive.h\"\n#include <ostream>\n";
+        for (int i = 0; kind != unit::header && i < types; ++i) {
+            out << "struct T" << i << " { int a; double b; };\n";
+            if (kind != unit::unrelated) {
+                out << "DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(T" << i << ", a, b);\n";
+            } else {
+                out << "inline T" << i << " operator+(T" << i << " l, T" << i << " r) { return { l.a + r.a, l.b + r.b }; }\n"
+                    << "inline bool operator==(T" << i << " l, T" << i << " r) { return l.a == r.a && l.b == r.b; }\n"
+                    << "inline std::ostream& operator<<(std::ostream& os, T" << i << " t) { return os << t.a << ' ' << t.b; }\n";
+            }
+            if (kind != unit::declared) {
+                out << "inline bool use" << i << "(std::ostream& os, T" << i << " t) { os << t + t; return t == t; }\n";
+            }
+        }
+    }
+
+    double compile_ms(const std::string& compiler, const std::string& standard, const std::string& path, int rounds) {
+        const std::string command = compiler + " -std=" + standard + " -fsyntax-only -I\"" + include_dir() + "\" \"" + path + "\"";
+        double best = 0;
+        for (int round = 0; round < rounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            if (std::system(command.c_str()) != 0) {
+                return -1;
+            }
+            auto end = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            best = (round == 0 || ms < best) ? ms : best;
+        }
+        return best;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int types = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 1;
+    const char* env = std::getenv("CXX");
+    const std::string compiler = env && *env ? env : "c++";
+    const std::string path = "dmopexcompilebench_unit.cpp";
+
+    const struct { unit kind; const char* name; } units[] = {
+        { unit::header, "header only" },
+        { unit::unrelated, "unrelated types" },
+        { unit::declared, "declared types" },
+        { unit::registered, "registered types" },
+    };
+
+    std::printf("%s -fsyntax-only, %d types, best of %d\n", compiler.c_str(), types, rounds);
+    std::printf("%-18s %12s %12s\n", "", "c++17 ms", "c++20 ms");
+    for (const auto& u : units) {
+        write_unit(path, u.kind, types);
+        double cpp17 = compile_ms(compiler, "c++17", path, rounds);
+        double cpp20 = compile_ms(compiler, "c++20", path, rounds);
+        std::printf("%-18s %12.0f %12.0f\n", u.name, cpp17, cpp20);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,115 @@
+﻿#include "dmopex.h"
+#include "dmopex_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+struct Vector3D {
+    double x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template<typename T>
+void run(const char* name, const std::vector<T>& items) {
+    std::size_t bytes = 0;
+
+    double stream_ms = measure_ms([&] {
+        std::ostringstream oss;
+        for (const auto& item : items) {
+            oss << item << '\n';
+        }
+        bytes = oss.str().size();
+    });
+
+    double format_ms = measure_ms([&] {
+        fmt::memory_buffer buf;
+        for (const auto& item : items) {
+            dmopex::format_to(buf, item);
+            buf.push_back('\n');
+        }
+        bytes = buf.size();
+    });
+
+    double named_ms = measure_ms([&] {
+        fmt::memory_buffer buf;
+        for (const auto& item : items) {
+            dmopex::format_to(buf, item, true);
+            buf.push_back('\n');
+        }
+    });
+
+    std::printf("%-10s %8zu items %10zu bytes | operator<< %8.2f ms | format_to %8.2f ms (x%.2f) | named %8.2f ms\n",
+        name, items.size(), bytes, stream_ms, format_ms, stream_ms / format_ms, named_ms);
+}
+
+int main() {
+    const std::size_t count = 200000;
+
+    std::vector<Vector3D> positions(count);
+    std::vector<Color> colors(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        positions[i] = Vector3D{ i * 0.25, i * -1.5, i / 3.0 };
+        colors[i] = Color{ int(i % 256), int(i * 7 % 256), int(i * 13 % 256), 255 };
+    }
+
+    run("Vector3D", positions);
+    run("Color", colors);
+
+    // 1e6 positions dumped to /dev/null (or NUL) through format_range
+    std::vector<Vector3D> dump(1000000);
+    for (std::size_t i = 0; i < dump.size(); ++i) {
+        dump[i] = Vector3D{ i * 0.25, i * -1.5, i / 3.0 };
+    }
+
+#ifdef _WIN32
+    std::FILE* null_file = std::fopen("NUL", "wb");
+#else
+    std::FILE* null_file = std::fopen("/dev/null", "wb");
+#endif
+    if (!null_file) {
+        return 1;
+    }
+
+    double stream_ms = measure_ms([&] {
+        std::ostringstream oss;
+        for (const auto& item : dump) {
+            oss << item << '\n';
+        }
+        std::fwrite(oss.str().data(), 1, oss.str().size(), null_file);
+    });
+    std::printf("format_range %zu Vector3D | operator<< %8.2f ms\n", dump.size(), stream_ms);
+
+    unsigned max_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        dmopex::format_range_options options;
+        options.threads = threads;
+        double range_ms = measure_ms([&] {
+            dmopex::format_range(dmopex::span<const Vector3D>(dump), [&](const char* data, std::size_t size) {
+                std::fwrite(data, 1, size, null_file);
+            }, options);
+        });
+        std::printf("format_range %zu Vector3D | %2u threads %8.2f ms (x%.2f)\n", dump.size(), threads, range_ms, stream_ms / range_ms);
+    }
+
+    std::fclose(null_file);
+    return 0;
+}
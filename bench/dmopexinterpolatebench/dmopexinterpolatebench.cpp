@@ -0,0 +1,111 @@
+﻿#include "dmopex.h"
+#include "dmopex_interpolate.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    // In-cache arrays, count read through a volatile so the loops keep a runtime trip count
+    volatile std::size_t runtime_count = 1 << 12;
+    const std::size_t count = runtime_count;
+    const int rounds = 5000;
+
+    std::vector<Vector3D> a(count), b(count), c(count), d(count), out(count);
+    std::vector<float> t(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        a[i] = Vector3D{ f, f * 0.5f, -f };
+        b[i] = Vector3D{ f + 1, f * 2.0f, f };
+        c[i] = Vector3D{ f - 1, 1.0f, f * 0.25f };
+        d[i] = Vector3D{ 2.0f, f, f + 3 };
+        t[i] = static_cast<float>(i % 100) / 100.0f;
+    }
+
+    double by_hand_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = a[i] + (b[i] - a[i]) * Vector3D{ t[i], t[i], t[i] };
+            }
+        }
+    });
+
+    double lerp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = dmopex::lerp(a[i], b[i], t[i]);
+            }
+        }
+    });
+
+    double batch_lerp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_lerp<Vector3D>(a, b, t, out);
+        }
+    });
+
+    double bezier_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = dmopex::bezier(a[i], b[i], c[i], d[i], t[i]);
+            }
+        }
+    });
+
+    double batch_bezier_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_bezier<Vector3D>(a, b, c, d, t, out);
+        }
+    });
+
+    // Same data as three float columns (structure of arrays), interpolated column by column
+    std::vector<float> ax(count), ay(count), az(count), bx(count), by(count), bz(count);
+    std::vector<float> cx(count), cy(count), cz(count), dx(count), dy(count), dz(count);
+    std::vector<float> ox(count), oy(count), oz(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ax[i] = a[i].x; ay[i] = a[i].y; az[i] = a[i].z;
+        bx[i] = b[i].x; by[i] = b[i].y; bz[i] = b[i].z;
+        cx[i] = c[i].x; cy[i] = c[i].y; cz[i] = c[i].z;
+        dx[i] = d[i].x; dy[i] = d[i].y; dz[i] = d[i].z;
+    }
+
+    double soa_lerp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_lerp<float>(ax, bx, t, ox);
+            dmopex::batch_lerp<float>(ay, by, t, oy);
+            dmopex::batch_lerp<float>(az, bz, t, oz);
+        }
+    });
+
+    double soa_bezier_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_bezier<float>(ax, bx, cx, dx, t, ox);
+            dmopex::batch_bezier<float>(ay, by, cy, dy, t, oy);
+            dmopex::batch_bezier<float>(az, bz, cz, dz, t, oz);
+        }
+    });
+
+    std::printf("Vector3D x %zu, %d rounds\n", count, rounds);
+    std::printf("a + (b - a) * t   %8.2f ms\n", by_hand_ms);
+    std::printf("dmopex::lerp      %8.2f ms (x%.2f)\n", lerp_ms, by_hand_ms / lerp_ms);
+    std::printf("batch_lerp        %8.2f ms (x%.2f)\n", batch_lerp_ms, by_hand_ms / batch_lerp_ms);
+    std::printf("batch_lerp SoA    %8.2f ms (x%.2f)\n", soa_lerp_ms, by_hand_ms / soa_lerp_ms);
+    std::printf("dmopex::bezier    %8.2f ms\n", bezier_ms);
+    std::printf("batch_bezier      %8.2f ms (x%.2f)\n", batch_bezier_ms, bezier_ms / batch_bezier_ms);
+    std::printf("batch_bezier SoA  %8.2f ms (x%.2f)\n", soa_bezier_ms, bezier_ms / soa_bezier_ms);
+    return 0;
+}
@@ -0,0 +1,98 @@
+﻿#include "dmopex.h"
+#include "dmopex_minmax.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    // In-cache arrays, count read through a volatile so the loops keep a runtime trip count
+    volatile std::size_t runtime_count = 1 << 12;
+    const std::size_t count = runtime_count;
+    const int rounds = 20000;
+
+    std::vector<Vector3D> points(count);
+    std::vector<Color> colors(count), clamped(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        points[i] = Vector3D{ f * 0.5f, 100.0f - f, static_cast<float>(i % 97) };
+        int c = static_cast<int>(i);
+        colors[i] = Color{ c - 1000, c % 300, 255 - c, c * 3 };
+    }
+
+    // Every round's box goes to a volatile, so no round can be dropped as dead code
+    volatile float sink = 0;
+    Vector3D lo{}, hi{};
+    double by_hand_bounds_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            lo = hi = points[0];
+            for (std::size_t i = 1; i < count; ++i) {
+                lo = Vector3D{ std::min(lo.x, points[i].x), std::min(lo.y, points[i].y), std::min(lo.z, points[i].z) };
+                hi = Vector3D{ std::max(hi.x, points[i].x), std::max(hi.y, points[i].y), std::max(hi.z, points[i].z) };
+            }
+            sink = lo.x + lo.y + lo.z + hi.x + hi.y + hi.z;
+        }
+    });
+
+    double bounds_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::aabb<Vector3D> box = dmopex::bounds<Vector3D>(points);
+            lo = box.lo;
+            hi = box.hi;
+            sink = lo.x + lo.y + lo.z + hi.x + hi.y + hi.z;
+        }
+    });
+
+    const Color black{ 0, 0, 0, 0 }, white{ 255, 255, 255, 255 };
+    double by_hand_clamp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const Color& c = colors[i];
+                clamped[i] = Color{ std::clamp(c.r, 0, 255), std::clamp(c.g, 0, 255), std::clamp(c.b, 0, 255), std::clamp(c.a, 0, 255) };
+            }
+        }
+    });
+
+    double clamp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                clamped[i] = dmopex::clamp(colors[i], black, white);
+            }
+        }
+    });
+
+    double batch_clamp_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_clamp<Color>(colors, black, white, clamped);
+        }
+    });
+
+    std::printf("x %zu, %d rounds\n", count, rounds);
+    std::printf("Vector3D bounds by hand  %8.2f ms\n", by_hand_bounds_ms);
+    std::printf("dmopex::bounds           %8.2f ms (x%.2f)\n", bounds_ms, by_hand_bounds_ms / bounds_ms);
+    std::printf("Color std::clamp         %8.2f ms\n", by_hand_clamp_ms);
+    std::printf("dmopex::clamp            %8.2f ms (x%.2f)\n", clamp_ms, by_hand_clamp_ms / clamp_ms);
+    std::printf("batch_clamp              %8.2f ms (x%.2f)\n", batch_clamp_ms, by_hand_clamp_ms / batch_clamp_ms);
+    return lo.x + hi.x + clamped[count / 2].r == 12345.0f ? 1 : 0;
+}
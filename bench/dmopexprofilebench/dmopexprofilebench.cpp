@@ -0,0 +1,56 @@
+﻿// Overhead of DMOPEX_PROFILE: the counted operator against the same addition written out
+#ifndef DMOPEX_PROFILE
+#define DMOPEX_PROFILE
+#endif
+
+#include "dmopex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    volatile std::size_t runtime_count = 1 << 12;
+    const std::size_t count = runtime_count;
+    const int rounds = 20000;
+
+    std::vector<Vector3D> a(count, Vector3D{ 1, 2, 3 }), b(count, Vector3D{ 0.5f, 0.5f, 0.5f }), out(count);
+
+    double plain_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = Vector3D{ a[i].x + b[i].x, a[i].y + b[i].y, a[i].z + b[i].z };
+            }
+        }
+    });
+
+    double counted_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = a[i] + b[i];
+            }
+        }
+    });
+
+    const double calls = static_cast<double>(count) * rounds;
+    std::printf("a + b, Vector3D x %zu, %d rounds\n", count, rounds);
+    std::printf("written out:        %8.2f ms\n", plain_ms);
+    std::printf("DMOPEX_PROFILE:     %8.2f ms (%.2f ns more per call)\n", counted_ms, (counted_ms - plain_ms) * 1e6 / calls);
+    dmopex::profile_dump(std::cout);
+    return 0;
+}
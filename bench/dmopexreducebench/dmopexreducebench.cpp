@@ -0,0 +1,89 @@
+﻿#include "dmopex.h"
+#include "dmopex_reduce.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    // In-cache arrays, count read through a volatile so the loops keep a runtime trip count
+    volatile std::size_t runtime_count = 1 << 12;
+    const std::size_t count = runtime_count;
+    const int rounds = 20000;
+
+    std::vector<Vector3D> a(count), b(count);
+    std::vector<float> out(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        a[i] = Vector3D{ f, f * 0.5f, -f };
+        b[i] = Vector3D{ 1.0f - f, 2.0f, f * 0.25f };
+    }
+
+    double by_hand_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+            }
+        }
+    });
+
+    double tuple_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                Vector3D p = a[i] * b[i];
+                out[i] = p.x + p.y + p.z;
+            }
+        }
+    });
+
+    double dot_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = dmopex::dot(a[i], b[i]);
+            }
+        }
+    });
+
+    double batch_dot_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_dot<Vector3D>(a, b, out);
+        }
+    });
+
+    double distance_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = dmopex::distance_squared(a[i], b[i]);
+            }
+        }
+    });
+
+    double batch_distance_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_distance_squared<Vector3D>(a, b, out);
+        }
+    });
+
+    std::printf("Vector3D x %zu, %d rounds\n", count, rounds);
+    std::printf("a.x * b.x + ...         %8.2f ms\n", by_hand_ms);
+    std::printf("sum of a * b            %8.2f ms (x%.2f)\n", tuple_ms, by_hand_ms / tuple_ms);
+    std::printf("dmopex::dot             %8.2f ms (x%.2f)\n", dot_ms, by_hand_ms / dot_ms);
+    std::printf("batch_dot               %8.2f ms (x%.2f)\n", batch_dot_ms, by_hand_ms / batch_dot_ms);
+    std::printf("distance_squared        %8.2f ms\n", distance_ms);
+    std::printf("batch_distance_squared  %8.2f ms (x%.2f)\n", batch_distance_ms, distance_ms / batch_distance_ms);
+    return out[count / 2] == 12345.0f ? 1 : 0;
+}
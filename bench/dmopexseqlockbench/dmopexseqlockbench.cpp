@@ -0,0 +1,129 @@
+﻿#include "dmopex.h"
+#include "dmopex_seqlock.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+struct Vector3D {
+    double x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Camera {
+    Vector3D position;
+    Vector3D target;
+    float fov, aspect;
+    std::uint32_t frame;
+
+    DEFINE_STRUCT_OPERATORS(Camera, position, target, fov, aspect, frame)
+};
+
+// Power-of-two buckets of nanoseconds: bucket b holds latencies in [2^b, 2^(b+1))
+struct histogram {
+    std::array<std::uint64_t, 40> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t max_ns = 0;
+
+    void add(std::uint64_t ns) {
+        std::size_t b = 0;
+        while (b + 1 < buckets.size() && (ns >> (b + 1)) != 0) {
+            ++b;
+        }
+        ++buckets[b];
+        ++count;
+        max_ns = ns > max_ns ? ns : max_ns;
+    }
+
+    void merge(const histogram& other) {
+        for (std::size_t b = 0; b < buckets.size(); ++b) {
+            buckets[b] += other.buckets[b];
+        }
+        count += other.count;
+        max_ns = other.max_ns > max_ns ? other.max_ns : max_ns;
+    }
+
+    // Upper bound of the bucket holding the given quantile
+    std::uint64_t percentile(double q) const {
+        std::uint64_t target = static_cast<std::uint64_t>(q * static_cast<double>(count));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < buckets.size(); ++b) {
+            seen += buckets[b];
+            if (seen > target) {
+                return std::uint64_t(1) << (b + 1);
+            }
+        }
+        return max_ns;
+    }
+};
+
+template<typename Publish, typename Read>
+histogram run(int readers, int reads_per_reader, Publish publish, Read read) {
+    std::atomic<int> finished{ 0 };
+    std::vector<histogram> results(readers);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            histogram& h = results[r];
+            std::uint32_t sink = 0;
+            for (int i = 0; i < reads_per_reader; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                sink += read().frame;
+                auto end = std::chrono::steady_clock::now();
+                h.add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+            finished += sink == 0xffffffffu ? 2 : 1;
+        });
+    }
+
+    // The writer publishes one frame after another until every reader is done
+    std::uint32_t frame = 0;
+    while (finished.load(std::memory_order_relaxed) < readers) {
+        ++frame;
+        double v = frame;
+        publish(Camera{ { v, v, v }, { -v, -v, -v }, 60.0f, 1.5f, frame });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    histogram total;
+    for (const auto& h : results) {
+        total.merge(h);
+    }
+    return total;
+}
+
+void report(const char* name, const histogram& h) {
+    std::printf("%-10s p50 %6llu ns | p90 %6llu ns | p99 %6llu ns | p99.9 %8llu ns | max %9llu ns\n", name,
+        (unsigned long long)h.percentile(0.5), (unsigned long long)h.percentile(0.9), (unsigned long long)h.percentile(0.99),
+        (unsigned long long)h.percentile(0.999), (unsigned long long)h.max_ns);
+}
+
+int main() {
+    const int reads_per_reader = 200000;
+    const unsigned cores = std::thread::hardware_concurrency();
+    std::printf("reader latency while the writer publishes continuously, %u hardware threads\n", cores);
+
+    for (int readers : { 1, 4, 16, 32 }) {
+        std::printf("-- %d readers\n", readers);
+
+        std::mutex mutex;
+        Camera locked{};
+        report("std::mutex", run(readers, reads_per_reader,
+            [&](const Camera& c) { std::lock_guard<std::mutex> lock(mutex); locked = c; },
+            [&] { std::lock_guard<std::mutex> lock(mutex); return locked; }));
+
+        dmopex::seqlock<Camera> cell;
+        report("seqlock", run(readers, reads_per_reader,
+            [&](const Camera& c) { cell.store(c); },
+            [&] { return cell.load(); }));
+    }
+    return 0;
+}
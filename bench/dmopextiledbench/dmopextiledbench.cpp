@@ -0,0 +1,144 @@
+﻿#include "dmopex.h"
+#include "dmopex_color.h"
+#include "dmopex_tiled.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// Best of three runs: memory-bound timings are noisy
+template<typename F>
+double measure_ms(F&& f) {
+    double best = 0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = run == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+struct best_setting {
+    double ms = 0;
+    const char* label = "";
+    char text[64] = {};
+};
+
+void keep_best(best_setting& best, double ms, const char* label) {
+    if (best.ms == 0 || ms < best.ms) {
+        best.ms = ms;
+        std::snprintf(best.text, sizeof(best.text), "%s", label);
+        best.label = best.text;
+    }
+}
+
+// Sweeps prefetch distance and streaming stores for out = a + b
+template<typename T>
+void sweep_single_pass(const char* name, const std::vector<T>& a, const std::vector<T>& b, std::vector<T>& out, int rounds) {
+    const std::size_t distances[] = { 0, 256, 1024, 4096, 16384 };
+    const double mib = sizeof(T) * a.size() / (1024.0 * 1024.0);
+    std::printf("out = a + b, %s x %zu (%.0f MiB per array), %d rounds\n", name, a.size(), mib, rounds);
+
+    double plain_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_add<T>(a, b, out);
+        }
+    });
+    std::printf("  batch_add (no options):       %8.2f ms\n", plain_ms);
+
+    best_setting best;
+    keep_best(best, plain_ms, "no options");
+    for (bool stream : { false, true }) {
+        for (std::size_t distance : distances) {
+            dmopex::tile_options options;
+            options.prefetch_bytes = distance;
+            options.stream_stores = stream;
+            double ms = measure_ms([&] {
+                for (int round = 0; round < rounds; ++round) {
+                    dmopex::batch_add<T>(a, b, out, options);
+                }
+            });
+            char label[64];
+            std::snprintf(label, sizeof(label), "prefetch %5zu, %s stores", distance, stream ? "stream" : "normal");
+            std::printf("  %-30s %8.2f ms (x%.2f)\n", label, ms, plain_ms / ms);
+            keep_best(best, ms, label);
+        }
+    }
+    std::printf("  best: %s\n\n", best.label);
+}
+
+// Sweeps the tile size of e = (a + b) * s - f run as three batch passes per tile; the
+// intermediates c and d are reused within the tile, e is not
+void sweep_tiles(const std::vector<Vector3D>& a, const std::vector<Vector3D>& b, const std::vector<Vector3D>& s,
+    const std::vector<Vector3D>& f, std::vector<Vector3D>& c, std::vector<Vector3D>& d, std::vector<Vector3D>& e, int rounds) {
+    using span = dmopex::span<const Vector3D>;
+    using out_span = dmopex::span<Vector3D>;
+    const std::size_t count = a.size();
+    const std::size_t tiles[] = { 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4096 * 1024 };
+    std::printf("e = (a + b) * s - f, Vector3D x %zu, three passes per tile, %d rounds\n", count, rounds);
+
+    double whole_ms = measure_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            dmopex::batch_add<Vector3D>(a, b, c);
+            dmopex::batch_mul<Vector3D>(c, s, d);
+            dmopex::batch_sub<Vector3D>(d, f, e);
+        }
+    });
+    std::printf("  whole arrays per pass:        %8.2f ms\n", whole_ms);
+
+    best_setting best;
+    keep_best(best, whole_ms, "whole arrays");
+    for (bool stream : { false, true }) {
+        for (std::size_t tile : tiles) {
+            dmopex::tile_options options;
+            options.tile_bytes = tile;
+            options.stream_stores = stream;
+            double ms = measure_ms([&] {
+                for (int round = 0; round < rounds; ++round) {
+                    dmopex::for_each_tile<Vector3D>(count, options, [&](std::size_t i, std::size_t n) {
+                        out_span c_tile = out_span(c).subspan(i, n);
+                        out_span d_tile = out_span(d).subspan(i, n);
+                        dmopex::batch_add<Vector3D>(span(a).subspan(i, n), span(b).subspan(i, n), c_tile);
+                        dmopex::batch_mul<Vector3D>(c_tile, span(s).subspan(i, n), d_tile);
+                        dmopex::batch_sub<Vector3D>(d_tile, span(f).subspan(i, n), out_span(e).subspan(i, n), options);
+                    });
+                }
+            });
+            char label[64];
+            std::snprintf(label, sizeof(label), "tile %5zu KiB, %s stores", tile / 1024, stream ? "stream" : "normal");
+            std::printf("  %-30s %8.2f ms (x%.2f)\n", label, ms, whole_ms / ms);
+            keep_best(best, ms, label);
+        }
+    }
+    std::printf("  best: %s\n", best.label);
+}
+
+int main() {
+    // 8M Vector3D (96 MiB per array) and 32M rgba8 (128 MiB per array): beyond the
+    // last-level cache, so every pass streams from memory
+    volatile std::size_t runtime_count = 1 << 23;
+    const std::size_t count = runtime_count;
+    const int rounds = 5;
+
+    {
+        std::vector<dmopex::rgba8> a(count * 4, dmopex::rgba8{ 10, 20, 30, 255 });
+        std::vector<dmopex::rgba8> b(count * 4, dmopex::rgba8{ 200, 100, 50, 0 });
+        std::vector<dmopex::rgba8> out(count * 4);
+        sweep_single_pass("rgba8", a, b, out, rounds);
+    }
+
+    std::vector<Vector3D> a(count, Vector3D{ 1, 2, 3 }), b(count, Vector3D{ 0.5f, 0.5f, 0.5f });
+    std::vector<Vector3D> s(count, Vector3D{ 2, 2, 2 }), f(count, Vector3D{ 1, 1, 1 });
+    std::vector<Vector3D> c(count), d(count), e(count);
+    sweep_single_pass("Vector3D", a, b, e, rounds);
+    sweep_tiles(a, b, s, f, c, d, e, rounds);
+    return 0;
+}
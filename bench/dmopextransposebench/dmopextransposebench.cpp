@@ -0,0 +1,164 @@
+﻿#include "dmopex.h"
+#include "dmopex_transpose.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Quat {
+    float x, y, z, w;
+
+    DEFINE_STRUCT_OPERATORS(Quat, x, y, z, w)
+};
+
+struct Vector2D {
+    double x, y;
+
+    DEFINE_STRUCT_OPERATORS(Vector2D, x, y)
+};
+
+template<typename F>
+double measure_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Every byte of the array read once and written once per round
+void report(const char* name, const char* method, std::size_t bytes, int rounds, double ms) {
+    std::printf("  %-10s %-22s %8.2f GB/s\n", name, method, 2.0 * bytes * rounds / (ms * 1e6));
+}
+
+int main() {
+    // Arrays of 256 KiB to 512 KiB, in L2 or L3; count read through a volatile so the
+    // loops keep a runtime trip count
+    volatile std::size_t runtime_count = 1 << 14;
+    const std::size_t count = runtime_count;
+    const int rounds = 5000;
+
+    std::printf("%zu elements, %d rounds\n", count, rounds);
+
+    {
+        std::vector<Vector3D> aos(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            float f = static_cast<float>(i);
+            aos[i] = Vector3D{ f, f * 0.5f, -f };
+        }
+        std::vector<float> xs(count), ys(count), zs(count);
+        const std::size_t bytes = count * sizeof(Vector3D);
+
+        report("Vector3D", "aos -> soa by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    xs[i] = aos[i].x;
+                    ys[i] = aos[i].y;
+                    zs[i] = aos[i].z;
+                }
+            }
+        }));
+        report("Vector3D", "dmopex::aos_to_soa", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::aos_to_soa<Vector3D>(aos, { xs.data(), ys.data(), zs.data() });
+            }
+        }));
+        report("Vector3D", "soa -> aos by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    aos[i].x = xs[i];
+                    aos[i].y = ys[i];
+                    aos[i].z = zs[i];
+                }
+            }
+        }));
+        report("Vector3D", "dmopex::soa_to_aos", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::soa_to_aos<Vector3D>({ xs.data(), ys.data(), zs.data() }, aos);
+            }
+        }));
+    }
+
+    {
+        std::vector<Quat> aos(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            float f = static_cast<float>(i);
+            aos[i] = Quat{ f, f + 1.0f, f + 2.0f, f + 3.0f };
+        }
+        std::vector<float> xs(count), ys(count), zs(count), ws(count);
+        const std::size_t bytes = count * sizeof(Quat);
+
+        report("Quat", "aos -> soa by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    xs[i] = aos[i].x;
+                    ys[i] = aos[i].y;
+                    zs[i] = aos[i].z;
+                    ws[i] = aos[i].w;
+                }
+            }
+        }));
+        report("Quat", "dmopex::aos_to_soa", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::aos_to_soa<Quat>(aos, { xs.data(), ys.data(), zs.data(), ws.data() });
+            }
+        }));
+        report("Quat", "soa -> aos by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    aos[i].x = xs[i];
+                    aos[i].y = ys[i];
+                    aos[i].z = zs[i];
+                    aos[i].w = ws[i];
+                }
+            }
+        }));
+        report("Quat", "dmopex::soa_to_aos", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::soa_to_aos<Quat>({ xs.data(), ys.data(), zs.data(), ws.data() }, aos);
+            }
+        }));
+    }
+
+    {
+        std::vector<Vector2D> aos(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            aos[i] = Vector2D{ i * 0.5, i * -2.0 };
+        }
+        std::vector<double> xs(count), ys(count);
+        const std::size_t bytes = count * sizeof(Vector2D);
+
+        report("Vector2D", "aos -> soa by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    xs[i] = aos[i].x;
+                    ys[i] = aos[i].y;
+                }
+            }
+        }));
+        report("Vector2D", "dmopex::aos_to_soa", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::aos_to_soa<Vector2D>(aos, { xs.data(), ys.data() });
+            }
+        }));
+        report("Vector2D", "soa -> aos by hand", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    aos[i].x = xs[i];
+                    aos[i].y = ys[i];
+                }
+            }
+        }));
+        report("Vector2D", "dmopex::soa_to_aos", bytes, rounds, measure_ms([&] {
+            for (int round = 0; round < rounds; ++round) {
+                dmopex::soa_to_aos<Vector2D>({ xs.data(), ys.data() }, aos);
+            }
+        }));
+    }
+    return 0;
+}
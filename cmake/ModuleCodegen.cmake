@@ -0,0 +1,32 @@
+# Codegen regression checks. Every subdirectory of ModulePath is compiled at -O2 into an
+# object library; cmake/CodegenCheck.cmake disassembles it and fails when a function
+# dmopex_<name> has more instructions than its hand-written counterpart hand_<name>.
+# The check is a ctest test named <subdir>, also runnable as the target of that name. It is
+# left out of the default build: instruction counts shift between compiler versions, and
+# that must not stop the headers from building.
+# It needs GCC or Clang and objdump, and is skipped elsewhere.
+macro(CodegenImport ModulePath)
+    message(STATUS "CodegenImport ${ModulePath}")
+
+    if (NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" OR NOT CMAKE_OBJDUMP)
+        message(STATUS "CodegenImport ${ModulePath} skipped: needs GCC or Clang and objdump")
+    elseif (IS_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/${ModulePath})
+        SUBDIRLIST(SUBDIRS ${CMAKE_CURRENT_SOURCE_DIR}/${ModulePath})
+        foreach(subdir ${SUBDIRS})
+            file(GLOB_RECURSE CODEGEN_SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/${ModulePath}/${subdir}/*.cpp)
+
+            add_library(${subdir}_objects OBJECT ${CODEGEN_SOURCES})
+            # Comes after the flags of the build type, so it overrides their -O level
+            target_compile_options(${subdir}_objects PRIVATE -O2)
+
+            set(CODEGEN_COMMAND ${CMAKE_COMMAND}
+                -DOBJDUMP=${CMAKE_OBJDUMP}
+                -DOBJECTS=$<TARGET_OBJECTS:${subdir}_objects>
+                -P ${CMAKE_CURRENT_SOURCE_DIR}/cmake/CodegenCheck.cmake)
+
+            add_custom_target(${subdir} COMMAND ${CODEGEN_COMMAND} VERBATIM)
+            add_dependencies(${subdir} ${subdir}_objects)
+            add_test(NAME ${subdir} COMMAND ${CODEGEN_COMMAND})
+        endforeach()
+    endif()
+endmacro()
@@ -0,0 +1,90 @@
+﻿// Functions compiled at -O2 and disassembled by cmake/CodegenCheck.cmake: every
+// dmopex_<name> must take no more instructions than the hand-written hand_<name>, i.e. the
+// tuples, policies and field metadata behind the operators must compile away. Known gaps
+// are listed, with their reason, as allowances in CodegenCheck.cmake. extern "C"
+// keeps the symbol names plain. Batch loops are not compared here: their vectorized blocks
+// are longer than a scalar loop by design, bench/ measures them.
+// Counting adds code by design; the operators are compared as built without it
+#undef DMOPEX_PROFILE
+#undef DMOPEX_PROFILE_CYCLES
+
+#include "dmopex.h"
+#include "dmopex_color.h"
+#include "dmopex_non_intrusive.h"
+
+#include <cstdint>
+
+struct Point2D {
+    int x, y;
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+struct Point2DNI {
+    int x, y;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Point2DNI, x, y)
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Segment {
+    Point2D from, to;
+
+    DEFINE_STRUCT_OPERATORS(Segment, from, to)
+};
+
+struct Quad {
+    int v[4];
+
+    DEFINE_STRUCT_OPERATORS(Quad, v)
+};
+
+extern "C" {
+    // Point2D addition through both headers
+    Point2D dmopex_point2d_add(Point2D a, Point2D b) { return a + b; }
+    Point2DNI dmopex_point2d_add_non_intrusive(Point2DNI a, Point2DNI b) { return a + b; }
+    Point2D hand_point2d_add(Point2D a, Point2D b) { return Point2D{ a.x + b.x, a.y + b.y }; }
+    Point2DNI hand_point2d_add_non_intrusive(Point2DNI a, Point2DNI b) { return Point2DNI{ a.x + b.x, a.y + b.y }; }
+
+    // The tuple round trip of to_tuple and from_tuple
+    Point2D dmopex_point2d_tuple_add(Point2D a, Point2D b) {
+        return Point2D::from_tuple(detail::tuple_op(a.to_tuple(), b.to_tuple(), [](int l, int r) { return l + r; }));
+    }
+    Point2D hand_point2d_tuple_add(Point2D a, Point2D b) { return Point2D{ a.x + b.x, a.y + b.y }; }
+
+    void dmopex_point2d_add_assign(Point2D* a, const Point2D* b) { *a += *b; }
+    void hand_point2d_add_assign(Point2D* a, const Point2D* b) {
+        a->x += b->x;
+        a->y += b->y;
+    }
+
+    bool dmopex_point2d_equal(const Point2D* a, const Point2D* b) { return *a == *b; }
+    bool hand_point2d_equal(const Point2D* a, const Point2D* b) { return a->x == b->x && a->y == b->y; }
+
+    Vector3D dmopex_vector3d_mul(Vector3D a, Vector3D b) { return a * b; }
+    Vector3D hand_vector3d_mul(Vector3D a, Vector3D b) { return Vector3D{ a.x * b.x, a.y * b.y, a.z * b.z }; }
+
+    // Nested reflected members and array members
+    Segment dmopex_segment_sub(Segment a, Segment b) { return a - b; }
+    Segment hand_segment_sub(Segment a, Segment b) {
+        return Segment{ { a.from.x - b.from.x, a.from.y - b.from.y }, { a.to.x - b.to.x, a.to.y - b.to.y } };
+    }
+
+    void dmopex_quad_add(Quad* out, const Quad* a, const Quad* b) { *out = *a + *b; }
+    void hand_quad_add(Quad* out, const Quad* a, const Quad* b) {
+        for (int i = 0; i < 4; ++i) {
+            out->v[i] = a->v[i] + b->v[i];
+        }
+    }
+
+    // Saturating policy. Allowed two more instructions in cmake/CodegenCheck.cmake
+    dmopex::rgba8 dmopex_rgba8_add(dmopex::rgba8 a, dmopex::rgba8 b) { return a + b; }
+    dmopex::rgba8 hand_rgba8_add(dmopex::rgba8 a, dmopex::rgba8 b) {
+        auto sat = [](unsigned l, unsigned r) { return static_cast<std::uint8_t>(l + r > 255 ? 255 : l + r); };
+        return dmopex::rgba8{ sat(a.r, b.r), sat(a.g, b.g), sat(a.b, b.b), sat(a.a, b.a) };
+    }
+}
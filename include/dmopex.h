@@ -6,6 +6,10 @@
 #include <utility>
 #include <type_traits>
 
+#include "dmopex_fields.h"
+#include "dmopex_policy.h"
+#include "dmopex_profile.h"
+
 namespace detail {
     template<typename Tuple1, typename Tuple2, typename Op, std::size_t... I>
     constexpr auto tuple_op_impl(const Tuple1& t1, const Tuple2& t2, Op op, std::index_sequence<I...>) {
@@ -22,15 +26,28 @@ namespace detail {
     template<typename Tuple, std::size_t... I>
     void print_tuple(std::ostream& os, const Tuple& t, std::index_sequence<I...>) {
         os << "(";
-        ((os << (I == 0 ? "" : ", ") << std::get<I>(t)), ...);
+        ((os << (I == 0 ? "" : ", "), dmopex::fields_detail::print_value(os, std::get<I>(t))), ...);
         os << ")";
     }
 } // namespace detail
 
 #define DEFINE_STRUCT_OPERATORS(StructName, ...) \
+    DEFINE_STRUCT_OPERATORS_EX(StructName, dmopex::wrap_policy, __VA_ARGS__)
+
+// Same as DEFINE_STRUCT_OPERATORS, with the arithmetic policy of dmopex_policy.h applied
+// to every member: dmopex::wrap_policy, dmopex::saturate_policy or dmopex::checked_policy.
+// The operators work member by member through the field metadata, so nested reflected
+// structs and array members (C arrays, std::array) are handled element-wise. They are
+// constexpr, and noexcept unless a member operation can throw (checked_policy integers).
+// Built with DMOPEX_PROFILE, they count their calls per thread (dmopex_profile.h).
+#define DEFINE_STRUCT_OPERATORS_EX(StructName, Policy, ...) \
 public: \
+    using operator_policy = Policy; \
+    \
+    template<typename Self = StructName> \
     constexpr auto to_tuple() const { \
-        return std::make_tuple(__VA_ARGS__); \
+        const Self& self = *this; \
+        return std::make_tuple(APPLY_OP_TO_EACH_MEMBER(OBJ_DOT_MEMBER, self, __VA_ARGS__)); \
     } \
     \
     template<typename TupleType> \
@@ -38,66 +55,72 @@ public: \
         return std::apply([](auto... args) { return StructName{args...}; }, t); \
     } \
     \
-    StructName operator+(const StructName& other) const { \
-        auto t1 = this->to_tuple(); \
-        auto t2 = other.to_tuple(); \
-        auto result_tuple = detail::tuple_op(t1, t2, [](auto a, auto b) { return a + b; }); \
-        return StructName::from_tuple(result_tuple); \
+    DEFINE_STRUCT_FIELDS(StructName, __VA_ARGS__) \
+    \
+    constexpr StructName operator+(const StructName& other) const \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::add_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
+        return DMOPEX_PROFILE_CALL(StructName, add, dmopex::policy_detail::compound<dmopex::policy_detail::add_op>(*this, other)); \
     } \
     \
-    StructName operator-(const StructName& other) const { \
-        auto t1 = this->to_tuple(); \
-        auto t2 = other.to_tuple(); \
-        auto result_tuple = detail::tuple_op(t1, t2, [](auto a, auto b) { return a - b; }); \
-        return StructName::from_tuple(result_tuple); \
+    constexpr StructName operator-(const StructName& other) const \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::sub_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
+        return DMOPEX_PROFILE_CALL(StructName, sub, dmopex::policy_detail::compound<dmopex::policy_detail::sub_op>(*this, other)); \
     } \
     \
-    StructName operator*(const StructName& other) const { \
-        auto t1 = this->to_tuple(); \
-        auto t2 = other.to_tuple(); \
-        auto result_tuple = detail::tuple_op(t1, t2, [](auto a, auto b) { return a * b; }); \
-        return StructName::from_tuple(result_tuple); \
+    constexpr StructName operator*(const StructName& other) const \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::mul_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
+        return DMOPEX_PROFILE_CALL(StructName, mul, dmopex::policy_detail::compound<dmopex::policy_detail::mul_op>(*this, other)); \
     } \
     \
-    StructName operator/(const StructName& other) const { \
-        auto t1 = this->to_tuple(); \
-        auto t2 = other.to_tuple(); \
-        auto result_tuple = detail::tuple_op(t1, t2, [](auto a, auto b) { return a / b; }); \
-        return StructName::from_tuple(result_tuple); \
+    constexpr StructName operator/(const StructName& other) const \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::div_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
+        return DMOPEX_PROFILE_CALL(StructName, div, dmopex::policy_detail::compound<dmopex::policy_detail::div_op>(*this, other)); \
     } \
     \
-    StructName& operator+=(const StructName& other) { \
+    constexpr StructName& operator+=(const StructName& other) \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::add_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
         *this = *this + other; \
         return *this; \
     } \
     \
-    StructName& operator-=(const StructName& other) { \
+    constexpr StructName& operator-=(const StructName& other) \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::sub_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
         *this = *this - other; \
         return *this; \
     } \
     \
-    StructName& operator*=(const StructName& other) { \
+    constexpr StructName& operator*=(const StructName& other) \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::mul_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
         *this = *this * other; \
         return *this; \
     } \
     \
-    StructName& operator/=(const StructName& other) { \
+    constexpr StructName& operator/=(const StructName& other) \
+        noexcept(dmopex::policy_detail::nothrow_members_v<dmopex::policy_detail::div_op, Policy, StructName, \
+            APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
         *this = *this / other; \
         return *this; \
     } \
     \
-    bool operator==(const StructName& other) const { \
-        return this->to_tuple() == other.to_tuple(); \
+    constexpr bool operator==(const StructName& other) const \
+        noexcept(dmopex::fields_detail::nothrow_equal_v<APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
+        return DMOPEX_PROFILE_CALL(StructName, equal, dmopex::fields_detail::equal(*this, other)); \
     } \
     \
-    bool operator!=(const StructName& other) const { \
+    constexpr bool operator!=(const StructName& other) const \
+        noexcept(dmopex::fields_detail::nothrow_equal_v<APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_TYPE, StructName, __VA_ARGS__)>) { \
         return !(*this == other); \
     } \
     \
     friend std::ostream& operator<<(std::ostream& os, const StructName& obj) { \
-        auto t = obj.to_tuple(); \
-        constexpr auto size = std::tuple_size_v<std::decay_t<decltype(t)>>; \
-        detail::print_tuple(os, t, std::make_index_sequence<size>{}); \
+        dmopex::fields_detail::print_value(os, obj); \
         return os; \
     }
 
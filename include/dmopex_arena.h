@@ -0,0 +1,190 @@
+﻿#ifndef __DMOPEX_ARENA_H_INCLUDE__
+#define __DMOPEX_ARENA_H_INCLUDE__
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_batch.h"
+
+// Bump allocator for the temporary arrays of batch pipelines, reset once per frame:
+//
+//   dmopex::arena& scratch = dmopex::arena::local();     // one per thread
+//   span<Vector3D> moved = dmopex::batch_add<Vector3D>(scratch, positions, velocities);
+//   span<Vector3D> scaled = dmopex::batch_mul<Vector3D>(scratch, moved, scales);
+//   span<float> lengths = scratch.allocate<float>(n);     // output of any other batch function
+//   ...
+//   scratch.reset();                                      // end of frame, every array released at once
+//
+// Allocation moves a pointer through a block of memory; nothing is freed before reset or
+// rewind. When a frame outgrows the block, more blocks are chained and the next reset
+// replaces them with a single block of the combined size, so after the first frames of
+// the largest size the arena no longer calls operator new. Arrays are aligned to a cache
+// line (or to alignof(T) when larger) and hold trivially destructible elements,
+// default-initialized (uninitialized for plain structs). An arena is not thread-safe: use one per thread, arena::local().
+
+namespace dmopex {
+    class arena {
+    public:
+        static constexpr std::size_t alignment = 64;
+
+        // Position to rewind to, for temporaries released before the end of the frame
+        struct marker {
+            std::size_t block;
+            std::size_t offset;
+        };
+
+        // Rewinds the arena to where it was on construction
+        class scope {
+        public:
+            explicit scope(arena& a) noexcept : arena_(a), mark_(a.mark()) {}
+            ~scope() { arena_.rewind(mark_); }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+        private:
+            arena& arena_;
+            marker mark_;
+        };
+
+        explicit arena(std::size_t capacity = 64 * 1024) {
+            if (capacity != 0) {
+                add_block(capacity);
+            }
+        }
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        // The arena of the calling thread
+        static arena& local() {
+            thread_local arena instance;
+            return instance;
+        }
+
+        template<typename T>
+        span<T> allocate(std::size_t n) {
+            static_assert(std::is_trivially_destructible_v<T>, "arena arrays are released without running destructors");
+            T* data = static_cast<T*>(allocate_bytes(n * sizeof(T), alignof(T) > alignment ? alignof(T) : alignment));
+            std::uninitialized_default_construct_n(data, n);
+            return span<T>(data, n);
+        }
+
+        void* allocate_bytes(std::size_t bytes, std::size_t align = alignment) {
+            while (current_ < blocks_.size()) {
+                block& b = blocks_[current_];
+                // Blocks are only aligned to a cache line: align the address, not the offset
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.data.get());
+                const std::size_t start = static_cast<std::size_t>(((base + offset_ + align - 1) & ~(std::uintptr_t(align) - 1)) - base);
+                if (start + bytes <= b.size) {
+                    offset_ = start + bytes;
+                    return b.data.get() + start;
+                }
+                ++current_;
+                offset_ = 0;
+            }
+            const std::size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+            add_block(bytes + align > 2 * last ? bytes + align : 2 * last);
+            return allocate_bytes(bytes, align);
+        }
+
+        marker mark() const noexcept { return { current_, offset_ }; }
+
+        // Releases everything allocated after m was taken
+        void rewind(const marker& m) noexcept {
+            current_ = m.block;
+            offset_ = m.offset;
+        }
+
+        // Releases everything; a frame that needed several blocks leaves one block of their
+        // combined size behind, so the next frame of the same size fits in it
+        void reset() {
+            if (blocks_.size() > 1) {
+                std::size_t total = 0;
+                for (const block& b : blocks_) {
+                    total += b.size;
+                }
+                blocks_.clear();
+                add_block(total);
+            }
+            current_ = 0;
+            offset_ = 0;
+        }
+
+        // Bytes in use up to the current position (alignment and skipped block ends included),
+        // and bytes held in blocks
+        std::size_t used() const noexcept {
+            std::size_t total = offset_;
+            for (std::size_t k = 0; k < current_ && k < blocks_.size(); ++k) {
+                total += blocks_[k].size;
+            }
+            return total;
+        }
+
+        std::size_t capacity() const noexcept {
+            std::size_t total = 0;
+            for (const block& b : blocks_) {
+                total += b.size;
+            }
+            return total;
+        }
+
+        std::size_t block_count() const noexcept { return blocks_.size(); }
+
+    private:
+        struct block_deleter {
+            void operator()(unsigned char* p) const noexcept { ::operator delete(p, std::align_val_t(alignment)); }
+        };
+
+        struct block {
+            std::unique_ptr<unsigned char, block_deleter> data;
+            std::size_t size;
+        };
+
+        void add_block(std::size_t size) {
+            size = (size + alignment - 1) / alignment * alignment;
+            blocks_.push_back(block{ std::unique_ptr<unsigned char, block_deleter>(
+                static_cast<unsigned char*>(::operator new(size, std::align_val_t(alignment)))), size });
+        }
+
+        std::vector<block> blocks_;
+        std::size_t current_ = 0;
+        std::size_t offset_ = 0;
+    };
+
+    // Batch arithmetic with the output allocated from an arena
+    template<typename T>
+    span<T> batch_add(arena& scratch, span<const T> a, span<const T> b) {
+        span<T> out = scratch.allocate<T>(a.size());
+        dmopex::batch_add<T>(a, b, out);
+        return out;
+    }
+
+    template<typename T>
+    span<T> batch_sub(arena& scratch, span<const T> a, span<const T> b) {
+        span<T> out = scratch.allocate<T>(a.size());
+        dmopex::batch_sub<T>(a, b, out);
+        return out;
+    }
+
+    template<typename T>
+    span<T> batch_mul(arena& scratch, span<const T> a, span<const T> b) {
+        span<T> out = scratch.allocate<T>(a.size());
+        dmopex::batch_mul<T>(a, b, out);
+        return out;
+    }
+
+    template<typename T>
+    span<T> batch_div(arena& scratch, span<const T> a, span<const T> b) {
+        span<T> out = scratch.allocate<T>(a.size());
+        dmopex::batch_div<T>(a, b, out);
+        return out;
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_ARENA_H_INCLUDE__
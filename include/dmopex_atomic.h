@@ -0,0 +1,301 @@
+﻿#ifndef __DMOPEX_ATOMIC_H_INCLUDE__
+#define __DMOPEX_ATOMIC_H_INCLUDE__
+
+#include <tuple>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "dmopex_fields.h"
+#include "dmopex_policy.h"
+
+// Lock-free shared accumulator for structs updated from many threads:
+//
+//   dmopex::atomic<SessionStats> stats;
+//   stats += delta;                            // from any thread
+//   SessionStats snapshot = stats.load();
+//
+// Structs of up to 16 bytes are kept in one machine word (two above 8 bytes) and updated
+// as a whole with a compare-and-swap loop, a double-width CAS (cmpxchg16b) for 9 to 16
+// bytes, so load() always returns a value produced by some sequence of updates.
+// Larger reflected structs keep one std::atomic per leaf member (nested reflected members
+// flattened): += and -= become a fetch_add / fetch_sub per member, or a CAS loop per
+// member for floating-point members and the saturate and checked policies. load(), store()
+// and exchange() are then atomic per member, not for the struct as a whole.
+//
+// Arithmetic follows the arithmetic policy of the struct (see dmopex_policy.h). A checked
+// overflow throws and leaves the value unchanged; with per-member storage the members
+// before the overflowing one keep their update.
+//
+// Define DMOPEX_NO_DWCAS to store structs of 9 to 16 bytes per member as well.
+
+#if !defined(DMOPEX_NO_DWCAS)
+#   if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#       define DMOPEX_ATOMIC_DWCAS 1
+#   elif defined(_MSC_VER) && defined(_M_X64)
+#       include <intrin.h>
+#       define DMOPEX_ATOMIC_DWCAS 1
+#   endif
+#endif
+
+namespace dmopex {
+    namespace atomic_detail {
+#if defined(DMOPEX_ATOMIC_DWCAS)
+        inline constexpr std::size_t whole_limit = 16;
+#else
+        inline constexpr std::size_t whole_limit = 8;
+#endif
+
+        template<typename T>
+        inline constexpr bool whole_v = sizeof(T) <= whole_limit;
+
+        // Structs of up to 8 bytes: one std::atomic<uint64_t>
+        class single_word {
+        public:
+            using word = std::uint64_t;
+
+            explicit single_word(word w) noexcept : word_(w) {}
+
+            word load(std::memory_order order) const noexcept { return word_.load(order); }
+            word peek() const noexcept { return word_.load(std::memory_order_relaxed); }
+
+            bool compare_exchange(word& expected, word desired, std::memory_order order) noexcept {
+                return word_.compare_exchange_weak(expected, desired, order);
+            }
+
+        private:
+            std::atomic<word> word_;
+        };
+
+#if defined(DMOPEX_ATOMIC_DWCAS)
+        // Structs of 9 to 16 bytes: two words swapped together by cmpxchg16b
+        class double_word {
+        public:
+            struct alignas(16) word {
+                std::uint64_t lo, hi;
+            };
+
+            explicit double_word(word w) noexcept : word_(w) {}
+
+            word load(std::memory_order) const noexcept {
+                // A CAS of 0 with 0 either fails and returns the current value, or succeeds
+                // because the value is 0 and leaves it unchanged
+                word current{ 0, 0 };
+                double_word::cas(&word_, current, current);
+                return current;
+            }
+
+            // First guess of a CAS loop: each half read atomically, a torn pair only makes the CAS retry
+            word peek() const noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+                return word{ static_cast<std::uint64_t>(__iso_volatile_load64(reinterpret_cast<const volatile long long*>(&word_.lo))),
+                    static_cast<std::uint64_t>(__iso_volatile_load64(reinterpret_cast<const volatile long long*>(&word_.hi))) };
+#else
+                return word{ __atomic_load_n(&word_.lo, __ATOMIC_RELAXED), __atomic_load_n(&word_.hi, __ATOMIC_RELAXED) };
+#endif
+            }
+
+            bool compare_exchange(word& expected, word desired, std::memory_order) noexcept {
+                return double_word::cas(&word_, expected, desired);
+            }
+
+        private:
+            // Stores desired when *dst equals expected, otherwise loads *dst into expected
+            static bool cas(word* dst, word& expected, const word& desired) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+                return _InterlockedCompareExchange128(reinterpret_cast<volatile long long*>(dst),
+                    static_cast<long long>(desired.hi), static_cast<long long>(desired.lo),
+                    reinterpret_cast<long long*>(&expected)) != 0;
+#else
+                bool ok;
+                __asm__ __volatile__("lock cmpxchg16b %1"
+                    : "=@ccz"(ok), "+m"(*dst), "+a"(expected.lo), "+d"(expected.hi)
+                    : "b"(desired.lo), "c"(desired.hi)
+                    : "memory");
+                return ok;
+#endif
+            }
+
+            mutable word word_;
+        };
+#endif
+
+        // Whole-struct storage: T is copied into the low bytes of a zeroed word. Every CAS
+        // compares against bits read back from memory, so padding bytes never cause spurious failures.
+        template<typename T>
+        class whole_storage {
+#if defined(DMOPEX_ATOMIC_DWCAS)
+            using storage = std::conditional_t<(sizeof(T) <= 8), single_word, double_word>;
+#else
+            using storage = single_word;
+#endif
+            using word = typename storage::word;
+
+        public:
+            explicit whole_storage(const T& value) noexcept : word_(encode(value)) {}
+
+            T load(std::memory_order order) const noexcept { return decode(word_.load(order)); }
+
+            T exchange(const T& value, std::memory_order order) noexcept {
+                return update([&](const T&) { return value; }, order);
+            }
+
+            template<typename Op>
+            T fetch(const T& value, std::memory_order order) {
+                return update([&](const T& current) { return policy_detail::compound<Op>(current, value); }, order);
+            }
+
+            static constexpr bool is_lock_free() noexcept { return true; }
+
+        private:
+            // Returns the value f replaced
+            template<typename F>
+            T update(F&& f, std::memory_order order) {
+                word expected = word_.peek();
+                while (!word_.compare_exchange(expected, encode(f(decode(expected))), order)) {
+                }
+                return decode(expected);
+            }
+
+            static word encode(const T& value) noexcept {
+                word w{};
+                std::memcpy(&w, &value, sizeof(T));
+                return w;
+            }
+
+            static T decode(const word& w) noexcept {
+                T value;
+                std::memcpy(&value, &w, sizeof(T));
+                return value;
+            }
+
+            storage word_;
+        };
+
+        template<typename Op, typename P, typename M>
+        M fetch_member(std::atomic<M>& member, M value, std::memory_order order) {
+            if constexpr (policy_detail::is_integer_v<M> && std::is_same_v<P, wrap_policy> && std::is_same_v<Op, policy_detail::add_op>) {
+                return member.fetch_add(value, order);
+            } else if constexpr (policy_detail::is_integer_v<M> && std::is_same_v<P, wrap_policy> && std::is_same_v<Op, policy_detail::sub_op>) {
+                return member.fetch_sub(value, order);
+            } else {
+                M expected = member.load(std::memory_order_relaxed);
+                while (!member.compare_exchange_weak(expected, Op::template apply<P>(expected, value), order)) {
+                }
+                return expected;
+            }
+        }
+
+        // One std::atomic per leaf member of T
+        template<typename T, typename Leaves = leaf_fields_t<T>>
+        class member_storage;
+
+        template<typename T, typename... Path>
+        class member_storage<T, std::tuple<Path...>> {
+            template<typename P>
+            using leaf_type = typename policy_detail::leaf_info<P>::type;
+
+            static_assert((std::is_arithmetic_v<leaf_type<Path>> && ...),
+                "dmopex::atomic stores structs larger than 16 bytes per member and needs arithmetic leaf members");
+
+        public:
+            explicit member_storage(const T& value) noexcept : leaves_(Path::get(value)...) {}
+
+            T load(std::memory_order order) const noexcept {
+                return load_leaves(order, std::index_sequence_for<Path...>{});
+            }
+
+            T exchange(const T& value, std::memory_order order) noexcept {
+                return exchange_leaves(value, order, std::index_sequence_for<Path...>{});
+            }
+
+            template<typename Op>
+            T fetch(const T& value, std::memory_order order) {
+                return fetch_leaves<Op>(value, order, std::index_sequence_for<Path...>{});
+            }
+
+            static bool is_lock_free() noexcept {
+                return (std::atomic<leaf_type<Path>>::is_always_lock_free && ...);
+            }
+
+        private:
+            template<std::size_t... I>
+            T load_leaves(std::memory_order order, std::index_sequence<I...>) const noexcept {
+                T result{};
+                ((Path::get(result) = std::get<I>(leaves_).load(order)), ...);
+                return result;
+            }
+
+            template<std::size_t... I>
+            T exchange_leaves(const T& value, std::memory_order order, std::index_sequence<I...>) noexcept {
+                T previous{};
+                ((Path::get(previous) = std::get<I>(leaves_).exchange(Path::get(value), order)), ...);
+                return previous;
+            }
+
+            template<typename Op, std::size_t... I>
+            T fetch_leaves(const T& value, std::memory_order order, std::index_sequence<I...>) {
+                T previous{};
+                ((Path::get(previous) = atomic_detail::fetch_member<Op, typename policy_detail::leaf_info<Path>::policy>(
+                    std::get<I>(leaves_), Path::get(value), order)), ...);
+                return previous;
+            }
+
+            std::tuple<std::atomic<leaf_type<Path>>...> leaves_;
+        };
+    } // namespace atomic_detail
+
+    template<typename T>
+    class atomic {
+        static_assert(std::is_trivially_copyable_v<T>, "dmopex::atomic requires a trivially copyable struct");
+        static_assert(atomic_detail::whole_v<T> || is_reflected_v<T>, "dmopex::atomic stores large structs per member and needs a reflected struct");
+
+        using storage = std::conditional_t<atomic_detail::whole_v<T>, atomic_detail::whole_storage<T>, atomic_detail::member_storage<T>>;
+
+    public:
+        using value_type = T;
+
+        // True when the struct is updated as a whole, false when it is stored per member
+        static constexpr bool whole_struct = atomic_detail::whole_v<T>;
+
+        atomic() noexcept : storage_(T{}) {}
+        explicit atomic(const T& value) noexcept : storage_(value) {}
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        T load(std::memory_order order = std::memory_order_seq_cst) const noexcept { return storage_.load(order); }
+        void store(const T& value, std::memory_order order = std::memory_order_seq_cst) noexcept { storage_.exchange(value, order); }
+        T exchange(const T& value, std::memory_order order = std::memory_order_seq_cst) noexcept { return storage_.exchange(value, order); }
+
+        // Return the previous value
+        T fetch_add(const T& value, std::memory_order order = std::memory_order_seq_cst) {
+            return storage_.template fetch<policy_detail::add_op>(value, order);
+        }
+
+        T fetch_sub(const T& value, std::memory_order order = std::memory_order_seq_cst) {
+            return storage_.template fetch<policy_detail::sub_op>(value, order);
+        }
+
+        // Return the new value, as for std::atomic
+        T operator+=(const T& value) { return policy_detail::compound<policy_detail::add_op>(fetch_add(value), value); }
+        T operator-=(const T& value) { return policy_detail::compound<policy_detail::sub_op>(fetch_sub(value), value); }
+
+        T operator=(const T& value) noexcept {
+            store(value);
+            return value;
+        }
+
+        operator T() const noexcept { return load(); }
+
+        bool is_lock_free() const noexcept { return storage_.is_lock_free(); }
+
+    private:
+        storage storage_;
+    };
+} // namespace dmopex
+
+#endif // __DMOPEX_ATOMIC_H_INCLUDE__
@@ -0,0 +1,170 @@
+﻿#ifndef __DMOPEX_BATCH_H_INCLUDE__
+#define __DMOPEX_BATCH_H_INCLUDE__
+
+#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_policy.h"
+
+// Element-wise arithmetic over arrays of structs:
+//
+//   dmopex::batch_add<Point2D>(a, b, out);   // out[i] = a[i] + b[i]
+//
+// Reflected structs are flattened to their leaf members (nested reflected members included)
+// and every leaf is computed with the policy of the struct declaring it, the same result as
+// the struct's own operators without building tuples. Array members are leaves computed
+// element by element. When all leaves share one arithmetic type and policy and the struct
+// has no padding, the arrays are processed as one flat array of leaves, a loop the compiler
+// vectorizes. Other types go through their own operators.
+// A batch_kernel specialization takes precedence, as for dmopex::rgba8.
+// out must hold at least a.size() elements and may be the same array as a or b.
+//
+// Define DMOPEX_NO_SIMD to compile the vectorized kernels down to their scalar fallbacks.
+
+#if !defined(DMOPEX_NO_SIMD)
+#   if defined(__AVX2__)
+#       include <immintrin.h>
+#       define DMOPEX_SIMD_AVX2 1
+#   endif
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       include <emmintrin.h>
+#       define DMOPEX_SIMD_SSE2 1
+#   elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#       include <arm_neon.h>
+#       define DMOPEX_SIMD_NEON 1
+#   endif
+#endif
+
+// Tells the compiler the next loop has no loop-carried dependencies. Valid for the
+// batch loops because out is either the same array as an input or does not overlap it.
+#if defined(__clang__)
+#   define DMOPEX_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#   define DMOPEX_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#   define DMOPEX_IVDEP __pragma(loop(ivdep))
+#else
+#   define DMOPEX_IVDEP
+#endif
+
+namespace dmopex {
+    namespace batch_detail {
+        // Policy operation for each of the std function objects used as batch Op
+        template<typename Op>
+        struct leaf_op {
+            using type = void;
+        };
+
+        template<> struct leaf_op<std::plus<>> { using type = policy_detail::add_op; };
+        template<> struct leaf_op<std::minus<>> { using type = policy_detail::sub_op; };
+        template<> struct leaf_op<std::multiplies<>> { using type = policy_detail::mul_op; };
+        template<> struct leaf_op<std::divides<>> { using type = policy_detail::div_op; };
+
+        using policy_detail::leaf_info;
+
+        template<typename T, typename Leaves = leaf_fields_t<T>>
+        struct flat_layout;
+
+        template<typename T, typename First, typename... Rest>
+        struct flat_layout<T, std::tuple<First, Rest...>> {
+            // Array members count as runs of their element type
+            using leaf_type = typename fields_detail::scalar_of<typename leaf_info<First>::type>::type;
+            using policy = typename leaf_info<First>::policy;
+
+            static constexpr bool value = std::is_standard_layout_v<T> && std::is_trivially_copyable_v<T> &&
+                std::is_arithmetic_v<leaf_type> &&
+                sizeof(T) == sizeof(typename leaf_info<First>::type) + (sizeof(typename leaf_info<Rest>::type) + ... + 0) &&
+                ((std::is_same_v<typename fields_detail::scalar_of<typename leaf_info<Rest>::type>::type, leaf_type> &&
+                    std::is_same_v<typename leaf_info<Rest>::policy, policy>) && ...);
+        };
+
+        template<typename Op, typename T, typename... Path>
+        void apply_paths(const T& a, const T& b, T& out, std::tuple<Path...>*) {
+            (policy_detail::assign<Op, typename leaf_info<Path>::policy>(Path::get(out), Path::get(a), Path::get(b)), ...);
+        }
+
+        template<typename Op, typename T>
+        void apply_leaves(const T* a, const T* b, T* out, std::size_t n) {
+            using layout = flat_layout<T>;
+            if constexpr (layout::value) {
+                // No padding and a single leaf type: the arrays are plain arrays of leaves.
+                // Fixed-size blocks keep the inner loop free of trip-count checks, so it
+                // vectorizes even under the cheap cost model of -O2.
+                using L = typename layout::leaf_type;
+                using P = typename layout::policy;
+                constexpr std::size_t block = 64 / sizeof(L) < 4 ? 4 : 64 / sizeof(L);
+                const L* x = reinterpret_cast<const L*>(a);
+                const L* y = reinterpret_cast<const L*>(b);
+                L* z = reinterpret_cast<L*>(out);
+                const std::size_t count = n * (sizeof(T) / sizeof(L));
+                std::size_t i = 0;
+                for (; i + block <= count; i += block) {
+                    DMOPEX_IVDEP
+                    for (std::size_t k = 0; k < block; ++k) {
+                        z[i + k] = Op::template apply<P>(x[i + k], y[i + k]);
+                    }
+                }
+                for (; i < count; ++i) {
+                    z[i] = Op::template apply<P>(x[i], y[i]);
+                }
+            } else {
+                for (std::size_t i = 0; i < n; ++i) {
+                    // Computed in a local copy so the leaves can be loaded and stored together
+                    T result = a[i];
+                    batch_detail::apply_paths<Op>(a[i], b[i], result, static_cast<leaf_fields_t<T>*>(nullptr));
+                    out[i] = result;
+                }
+            }
+        }
+    } // namespace batch_detail
+
+    // Computes out[i] = Op()(a[i], b[i]) for i < n, Op being std::plus<>, std::minus<>,
+    // std::multiplies<> or std::divides<>. Specialize for a (type, Op) pair to vectorize it.
+    template<typename T, typename Op, typename = void>
+    struct batch_kernel {
+        static void apply(const T* a, const T* b, T* out, std::size_t n) {
+            using leaf = typename batch_detail::leaf_op<Op>::type;
+            if constexpr (is_reflected_v<T> && !std::is_void_v<leaf>) {
+                batch_detail::apply_leaves<leaf>(a, b, out, n);
+            } else {
+                Op op;
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = op(a[i], b[i]);
+                }
+            }
+        }
+    };
+
+    template<typename T, typename Op>
+    void batch_apply(span<const T> a, span<const T> b, span<T> out, Op) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        batch_kernel<T, Op>::apply(a.data(), b.data(), out.data(), a.size());
+    }
+
+    template<typename T>
+    void batch_add(span<const T> a, span<const T> b, span<T> out) {
+        dmopex::batch_apply(a, b, out, std::plus<>{});
+    }
+
+    template<typename T>
+    void batch_sub(span<const T> a, span<const T> b, span<T> out) {
+        dmopex::batch_apply(a, b, out, std::minus<>{});
+    }
+
+    template<typename T>
+    void batch_mul(span<const T> a, span<const T> b, span<T> out) {
+        dmopex::batch_apply(a, b, out, std::multiplies<>{});
+    }
+
+    template<typename T>
+    void batch_div(span<const T> a, span<const T> b, span<T> out) {
+        dmopex::batch_apply(a, b, out, std::divides<>{});
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_BATCH_H_INCLUDE__
@@ -0,0 +1,275 @@
+﻿#ifndef __DMOPEX_COLUMN_H_INCLUDE__
+#define __DMOPEX_COLUMN_H_INCLUDE__
+
+#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_policy.h"
+#include "dmopex_reduce.h"
+#include "dmopex_minmax.h"
+
+// Strided views over one member of an array of structs, without copying it out:
+//
+//   dmopex::column_view<float> xs = dmopex::column<&Particle::x>(particles);
+//   dmopex::batch_add(xs, dmopex::column<&Particle::vx>(particles), xs);   // x += vx, other members untouched
+//   float total = dmopex::sum_of(dmopex::column<&Particle::mass>(particles));
+//   float lowest = dmopex::min_of(xs);                                      // also max_of, bounds, dot
+//   std::sort(xs.begin(), xs.end());                                        // random-access iterators
+//
+// The view keeps the arithmetic policy of the struct declaring the member, so batch
+// arithmetic on a column gives the same result as the struct's own operators. Batch
+// functions write out[i] for i < a.size(), out may be the same column as an input.
+// Reductions keep eight independent accumulators, element i going to accumulator i % 8,
+// so that several strided loads are in flight at once; sums are therefore added in a
+// different order than a plain loop. For passes over several members at once, or
+// repeated passes, dmopex::aos_to_soa (dmopex_transpose.h) pays for itself.
+
+namespace dmopex {
+    // Elements of type E every stride bytes; const E for read-only views
+    template<typename E, typename Policy = wrap_policy>
+    class column_view {
+        using byte = std::conditional_t<std::is_const_v<E>, const unsigned char, unsigned char>;
+
+    public:
+        using element_type = E;
+        using value_type = std::remove_cv_t<E>;
+        using policy = Policy;
+
+        class iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<E>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = E*;
+            using reference = E&;
+
+            constexpr iterator() noexcept = default;
+            constexpr iterator(E* at, std::ptrdiff_t stride) noexcept : at_(at), stride_(stride) {}
+
+            constexpr E& operator*() const noexcept { return *at_; }
+            constexpr E* operator->() const noexcept { return at_; }
+            constexpr E& operator[](difference_type k) const noexcept { return *(*this + k); }
+
+            constexpr iterator& operator++() noexcept { return *this += 1; }
+            constexpr iterator& operator--() noexcept { return *this -= 1; }
+            constexpr iterator operator++(int) noexcept { iterator old = *this; ++*this; return old; }
+            constexpr iterator operator--(int) noexcept { iterator old = *this; --*this; return old; }
+
+            constexpr iterator& operator+=(difference_type k) noexcept {
+                at_ = reinterpret_cast<E*>(reinterpret_cast<byte*>(at_) + k * stride_);
+                return *this;
+            }
+            constexpr iterator& operator-=(difference_type k) noexcept { return *this += -k; }
+
+            friend constexpr iterator operator+(iterator it, difference_type k) noexcept { return it += k; }
+            friend constexpr iterator operator+(difference_type k, iterator it) noexcept { return it += k; }
+            friend constexpr iterator operator-(iterator it, difference_type k) noexcept { return it -= k; }
+            friend constexpr difference_type operator-(const iterator& a, const iterator& b) noexcept {
+                return (reinterpret_cast<byte*>(a.at_) - reinterpret_cast<byte*>(b.at_)) / a.stride_;
+            }
+
+            friend constexpr bool operator==(const iterator& a, const iterator& b) noexcept { return a.at_ == b.at_; }
+            friend constexpr bool operator!=(const iterator& a, const iterator& b) noexcept { return a.at_ != b.at_; }
+            friend constexpr bool operator<(const iterator& a, const iterator& b) noexcept { return b - a > 0; }
+            friend constexpr bool operator>(const iterator& a, const iterator& b) noexcept { return b < a; }
+            friend constexpr bool operator<=(const iterator& a, const iterator& b) noexcept { return !(b < a); }
+            friend constexpr bool operator>=(const iterator& a, const iterator& b) noexcept { return !(a < b); }
+
+        private:
+            E* at_ = nullptr;
+            std::ptrdiff_t stride_ = sizeof(E);
+        };
+
+        constexpr column_view() noexcept = default;
+
+        constexpr column_view(E* first, std::size_t size, std::ptrdiff_t stride) noexcept
+            : data_(first), size_(size), stride_(stride) {}
+
+        // Contiguous elements, e.g. a column of a structure of arrays
+        constexpr column_view(span<E> elements) noexcept
+            : data_(elements.data()), size_(elements.size()), stride_(sizeof(E)) {}
+
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], E(*)[]>>>
+        constexpr column_view(const column_view<U, Policy>& other) noexcept
+            : data_(other.data()), size_(other.size()), stride_(other.stride()) {}
+
+        constexpr E* data() const noexcept { return data_; }
+        constexpr std::size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+        // Distance in bytes between consecutive elements
+        constexpr std::ptrdiff_t stride() const noexcept { return stride_; }
+
+        constexpr iterator begin() const noexcept { return iterator(data_, stride_); }
+        constexpr iterator end() const noexcept { return begin() + static_cast<std::ptrdiff_t>(size_); }
+
+        constexpr E& operator[](std::size_t i) const noexcept {
+            return *reinterpret_cast<E*>(reinterpret_cast<byte*>(data_) + static_cast<std::ptrdiff_t>(i) * stride_);
+        }
+
+        constexpr column_view first(std::size_t count) const noexcept { return column_view(data_, count, stride_); }
+        constexpr column_view subspan(std::size_t offset, std::size_t count) const noexcept { return column_view(&(*this)[offset], count, stride_); }
+        constexpr column_view subspan(std::size_t offset) const noexcept { return subspan(offset, size_ - offset); }
+
+    private:
+        E* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::ptrdiff_t stride_ = sizeof(E);
+    };
+
+    namespace column_detail {
+        template<auto Member>
+        using class_of = typename fields_detail::member_pointer<decltype(Member)>::class_type;
+
+        template<auto Member>
+        using member_of = typename fields_detail::member_pointer<decltype(Member)>::member_type;
+
+        template<typename T, typename M>
+        using copy_const = std::conditional_t<std::is_const_v<T>, const M, M>;
+    } // namespace column_detail
+
+    // View over the member Member of every element of a contiguous range (span, std::vector,
+    // C array, ...) that outlives the view; read-only when the elements are const
+    template<auto Member, typename Range, typename = std::enable_if_t<span_detail::borrowed_v<Range>>>
+    auto column(Range&& range) noexcept {
+        using T = std::remove_pointer_t<decltype(std::data(range))>;
+        static_assert(std::is_member_object_pointer_v<decltype(Member)> && std::is_base_of_v<column_detail::class_of<Member>, std::remove_cv_t<T>>,
+            "dmopex::column expects a pointer to a data member of the element type");
+        using E = column_detail::copy_const<T, column_detail::member_of<Member>>;
+        using view = column_view<E, policy_of_t<column_detail::class_of<Member>>>;
+        T* first = std::data(range);
+        const std::size_t size = std::size(range);
+        return size == 0 ? view(nullptr, 0, sizeof(T)) : view(&(first->*Member), size, sizeof(T));
+    }
+
+    // A temporary container is destroyed before the view could be used
+    template<auto Member, typename Range>
+    std::enable_if_t<!span_detail::borrowed_v<Range>> column(Range&&) = delete;
+
+    namespace column_detail {
+        // Accumulators of a reduction
+        constexpr std::size_t lanes = 8;
+
+        // Unrolled, so that the accumulators stay in registers
+        template<typename C, typename Step, std::size_t... L, typename... E, typename... P>
+        void step_lanes(C (&acc)[lanes], Step& step, std::size_t i, std::index_sequence<L...>, const column_view<E, P>&... in) {
+            auto lane = [&](std::size_t e) { acc[e] = step(acc[e], in[i + e]...); };
+            (lane(L), ...);
+        }
+
+        // Fold of step over the elements of the columns, element i going to lane i % lanes and
+        // the lanes combined in order at the end; step(acc, v...) takes one value per column
+        template<typename C, typename Step, typename Combine, typename... E, typename... P>
+        C fold(C init, Step step, Combine combine, const column_view<E, P>&... in) {
+            const std::size_t n = std::get<0>(std::tie(in...)).size();
+            assert(((in.size() == n) && ...));
+            C acc[lanes];
+            for (std::size_t e = 0; e < lanes; ++e) {
+                acc[e] = init;
+            }
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                column_detail::step_lanes(acc, step, i, std::make_index_sequence<lanes>{}, in...);
+            }
+            for (std::size_t e = 0; i + e < n; ++e) {
+                acc[e] = step(acc[e], in[i + e]...);
+            }
+            C result = acc[0];
+            for (std::size_t e = 1; e < lanes; ++e) {
+                result = combine(result, acc[e]);
+            }
+            return result;
+        }
+
+        template<typename Op, typename A, typename B, typename E, typename P, typename PA, typename PB>
+        void batch_apply(const column_view<A, PA>& a, const column_view<B, PB>& b, const column_view<E, P>& out) {
+            static_assert(std::is_same_v<std::remove_cv_t<A>, E> && std::is_same_v<std::remove_cv_t<B>, E>,
+                "dmopex batch functions on columns take columns of one member type");
+            assert(a.size() == b.size() && out.size() >= a.size());
+            auto x = a.begin();
+            auto y = b.begin();
+            auto z = out.begin();
+            for (auto end = a.end(); x != end; ++x, ++y, ++z) {
+                policy_detail::assign<Op, P>(*z, *x, *y);
+            }
+        }
+
+        template<typename E>
+        using sum_t = reduce_detail::sum_t<std::remove_cv_t<E>>;
+
+        template<typename C>
+        constexpr C zero() noexcept { return std::is_floating_point_v<C> ? C(-0.0) : C(0); }
+    } // namespace column_detail
+
+    // out[i] = a[i] op b[i] under the policy of out's struct
+    template<typename A, typename B, typename E, typename PA, typename PB, typename P>
+    void batch_add(const column_view<A, PA>& a, const column_view<B, PB>& b, const column_view<E, P>& out) {
+        column_detail::batch_apply<policy_detail::add_op>(a, b, out);
+    }
+
+    template<typename A, typename B, typename E, typename PA, typename PB, typename P>
+    void batch_sub(const column_view<A, PA>& a, const column_view<B, PB>& b, const column_view<E, P>& out) {
+        column_detail::batch_apply<policy_detail::sub_op>(a, b, out);
+    }
+
+    template<typename A, typename B, typename E, typename PA, typename PB, typename P>
+    void batch_mul(const column_view<A, PA>& a, const column_view<B, PB>& b, const column_view<E, P>& out) {
+        column_detail::batch_apply<policy_detail::mul_op>(a, b, out);
+    }
+
+    template<typename A, typename B, typename E, typename PA, typename PB, typename P>
+    void batch_div(const column_view<A, PA>& a, const column_view<B, PB>& b, const column_view<E, P>& out) {
+        column_detail::batch_apply<policy_detail::div_op>(a, b, out);
+    }
+
+    // Sum of an arithmetic column, computed in reduce_detail::sum_t as dmopex::sum_members
+    template<typename E, typename P>
+    column_detail::sum_t<E> sum_of(const column_view<E, P>& a) {
+        static_assert(std::is_arithmetic_v<std::remove_cv_t<E>>, "dmopex::sum_of takes a column of arithmetic values");
+        using C = column_detail::sum_t<E>;
+        return column_detail::fold(column_detail::zero<C>(), [](C acc, auto v) { return acc + C(v); }, std::plus<C>{}, a);
+    }
+
+    // Sum of a[i] * b[i]
+    template<typename A, typename B, typename PA, typename PB>
+    column_detail::sum_t<A> dot(const column_view<A, PA>& a, const column_view<B, PB>& b) {
+        static_assert(std::is_arithmetic_v<std::remove_cv_t<A>> && std::is_same_v<std::remove_cv_t<A>, std::remove_cv_t<B>>,
+            "dmopex::dot takes two columns of one arithmetic type");
+        using C = column_detail::sum_t<A>;
+        return column_detail::fold(column_detail::zero<C>(), [](C acc, auto x, auto y) { return acc + C(x) * C(y); }, std::plus<C>{}, a, b);
+    }
+
+    // Member-wise minimum, maximum or both of a non-empty column, as for arrays in dmopex_minmax.h
+    template<typename E, typename P>
+    std::remove_cv_t<E> min_of(const column_view<E, P>& a) {
+        assert(!a.empty());
+        using V = std::remove_cv_t<E>;
+        auto lower = [](const V& acc, const V& v) { return (dmopex::min)(acc, v); };
+        return column_detail::fold(V(a[0]), lower, lower, a);
+    }
+
+    template<typename E, typename P>
+    std::remove_cv_t<E> max_of(const column_view<E, P>& a) {
+        assert(!a.empty());
+        using V = std::remove_cv_t<E>;
+        auto upper = [](const V& acc, const V& v) { return (dmopex::max)(acc, v); };
+        return column_detail::fold(V(a[0]), upper, upper, a);
+    }
+
+    template<typename E, typename P>
+    aabb<std::remove_cv_t<E>> bounds(const column_view<E, P>& a) {
+        assert(!a.empty());
+        using box = aabb<std::remove_cv_t<E>>;
+        return column_detail::fold(box{ a[0], a[0] },
+            [](const box& acc, const auto& v) { return box{ (dmopex::min)(acc.lo, v), (dmopex::max)(acc.hi, v) }; },
+            [](const box& x, const box& y) { return box{ (dmopex::min)(x.lo, y.lo), (dmopex::max)(x.hi, y.hi) }; }, a);
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_COLUMN_H_INCLUDE__
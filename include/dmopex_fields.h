@@ -0,0 +1,518 @@
+﻿#ifndef __DMOPEX_FIELDS_H_INCLUDE__
+#define __DMOPEX_FIELDS_H_INCLUDE__
+
+#include <array>
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+
+// --- Preprocessor helpers for variadic macros ---
+
+// EXPAND macro to force another round of argument expansion if needed.
+#define EXPAND(...) __VA_ARGS__
+
+// Corrected PP_NARG to count arguments in __VA_ARGS__ (supports 0 to 64 arguments)
+#define PP_NARG_IMPL( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+    _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, \
+    _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, \
+    _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, \
+    _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, \
+    _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, \
+    _61, _62, _63, _64, N, ...) N
+
+#define PP_NARG(...) \
+    EXPAND(PP_NARG_IMPL(__VA_ARGS__, \
+    64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, \
+    48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, \
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, \
+    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+
+// Concatenation helpers: PASTE(a,b) expands to a ## b after 'a' and 'b' are expanded
+#define PASTE_IMPL(a, b) a##b
+#define PASTE(a, b) PASTE_IMPL(a, b)
+
+
+// FOR_EACH style macros to apply an operation to each argument (up to 64)
+#define FE_1(OP, OBJ, M1) OP(OBJ, M1)
+#define FE_2(OP, OBJ, M1, M2) OP(OBJ, M1), OP(OBJ, M2)
+#define FE_3(OP, OBJ, M1, M2, M3) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3)
+#define FE_4(OP, OBJ, M1, M2, M3, M4) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4)
+#define FE_5(OP, OBJ, M1, M2, M3, M4, M5) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5)
+#define FE_6(OP, OBJ, M1, M2, M3, M4, M5, M6) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6)
+#define FE_7(OP, OBJ, M1, M2, M3, M4, M5, M6, M7) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7)
+#define FE_8(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8)
+#define FE_9(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9)
+#define FE_10(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10)
+#define FE_11(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11)
+#define FE_12(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11), OP(OBJ, M12)
+#define FE_13(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11), OP(OBJ, M12), OP(OBJ, M13)
+#define FE_14(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11), OP(OBJ, M12), OP(OBJ, M13), OP(OBJ, M14)
+#define FE_15(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11), OP(OBJ, M12), OP(OBJ, M13), OP(OBJ, M14), OP(OBJ, M15)
+#define FE_16(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16) OP(OBJ, M1), OP(OBJ, M2), OP(OBJ, M3), OP(OBJ, M4), OP(OBJ, M5), OP(OBJ, M6), OP(OBJ, M7), OP(OBJ, M8), OP(OBJ, M9), OP(OBJ, M10), OP(OBJ, M11), OP(OBJ, M12), OP(OBJ, M13), OP(OBJ, M14), OP(OBJ, M15), OP(OBJ, M16)
+#define FE_17(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17) \
+    FE_16(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16), OP(OBJ, M17)
+#define FE_18(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18) \
+    FE_17(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17), OP(OBJ, M18)
+#define FE_19(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19) \
+    FE_18(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18), OP(OBJ, M19)
+#define FE_20(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20) \
+    FE_19(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19), OP(OBJ, M20)
+#define FE_21(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21) \
+    FE_20(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20), OP(OBJ, M21)
+#define FE_22(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22) \
+    FE_21(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21), OP(OBJ, M22)
+#define FE_23(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23) \
+    FE_22(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22), OP(OBJ, M23)
+#define FE_24(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24) \
+    FE_23(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23), OP(OBJ, M24)
+#define FE_25(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25) \
+    FE_24(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24), OP(OBJ, M25)
+#define FE_26(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26) \
+    FE_25(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25), OP(OBJ, M26)
+#define FE_27(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27) \
+    FE_26(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26), OP(OBJ, M27)
+#define FE_28(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28) \
+    FE_27(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27), OP(OBJ, M28)
+#define FE_29(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29) \
+    FE_28(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28), OP(OBJ, M29)
+#define FE_30(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30) \
+    FE_29(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29), OP(OBJ, M30)
+#define FE_31(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31) \
+    FE_30(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30), OP(OBJ, M31)
+#define FE_32(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32) \
+    FE_31(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31), OP(OBJ, M32)
+#define FE_33(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33) \
+    FE_32(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32), OP(OBJ, M33)
+#define FE_34(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34) \
+    FE_33(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33), OP(OBJ, M34)
+#define FE_35(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35) \
+    FE_34(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34), OP(OBJ, M35)
+#define FE_36(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36) \
+    FE_35(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35), OP(OBJ, M36)
+#define FE_37(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37) \
+    FE_36(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36), OP(OBJ, M37)
+#define FE_38(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38) \
+    FE_37(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37), OP(OBJ, M38)
+#define FE_39(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39) \
+    FE_38(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38), OP(OBJ, M39)
+#define FE_40(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40) \
+    FE_39(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39), OP(OBJ, M40)
+#define FE_41(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41) \
+    FE_40(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40), OP(OBJ, M41)
+#define FE_42(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42) \
+    FE_41(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41), OP(OBJ, M42)
+#define FE_43(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43) \
+    FE_42(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42), OP(OBJ, M43)
+#define FE_44(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44) \
+    FE_43(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43), OP(OBJ, M44)
+#define FE_45(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45) \
+    FE_44(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44), OP(OBJ, M45)
+#define FE_46(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46) \
+    FE_45(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45), OP(OBJ, M46)
+#define FE_47(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47) \
+    FE_46(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46), OP(OBJ, M47)
+#define FE_48(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48) \
+    FE_47(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47), OP(OBJ, M48)
+#define FE_49(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49) \
+    FE_48(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48), OP(OBJ, M49)
+#define FE_50(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50) \
+    FE_49(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49), OP(OBJ, M50)
+#define FE_51(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51) \
+    FE_50(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50), OP(OBJ, M51)
+#define FE_52(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52) \
+    FE_51(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51), OP(OBJ, M52)
+#define FE_53(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53) \
+    FE_52(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52), OP(OBJ, M53)
+#define FE_54(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54) \
+    FE_53(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53), OP(OBJ, M54)
+#define FE_55(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55) \
+    FE_54(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54), OP(OBJ, M55)
+#define FE_56(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56) \
+    FE_55(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55), OP(OBJ, M56)
+#define FE_57(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57) \
+    FE_56(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56), OP(OBJ, M57)
+#define FE_58(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58) \
+    FE_57(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57), OP(OBJ, M58)
+#define FE_59(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59) \
+    FE_58(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58), OP(OBJ, M59)
+#define FE_60(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60) \
+    FE_59(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59), OP(OBJ, M60)
+#define FE_61(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61) \
+    FE_60(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60), OP(OBJ, M61)
+#define FE_62(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62) \
+    FE_61(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61), OP(OBJ, M62)
+#define FE_63(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62, M63) \
+    FE_62(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62), OP(OBJ, M63)
+#define FE_64(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62, M63, M64) \
+    FE_63(OP, OBJ, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62, M63), OP(OBJ, M64)
+
+
+// Multi-level macro expansion for applying operation to each member
+// LVL2: The final call to the FE_N macro
+#define APPLY_OP_TO_EACH_MEMBER_LVL2(MACRO_NAME_TOKEN, OP_ARG, OBJ_ARG, ...) \
+    EXPAND(MACRO_NAME_TOKEN(OP_ARG, OBJ_ARG, __VA_ARGS__))
+
+// LVL1: Constructs the FE_N macro name (e.g., FE_2) using PASTE and the argument count
+#define APPLY_OP_TO_EACH_MEMBER_LVL1(NUM_ARGS_VAL, OP_ARG, OBJ_ARG, ...) \
+    APPLY_OP_TO_EACH_MEMBER_LVL2(PASTE(FE_, NUM_ARGS_VAL), OP_ARG, OBJ_ARG, __VA_ARGS__)
+
+// Main entry point: Calculates arg count and starts the expansion chain
+#define APPLY_OP_TO_EACH_MEMBER(OP_ARG, OBJ_ARG, ...) \
+    EXPAND(APPLY_OP_TO_EACH_MEMBER_LVL1(PP_NARG(__VA_ARGS__), OP_ARG, OBJ_ARG, __VA_ARGS__))
+
+
+// The operation to apply: obj.member
+#define OBJ_DOT_MEMBER(obj_name, member_name) obj_name.member_name
+
+// The operation to apply: "member"
+#define OBJ_MEMBER_NAME(obj_name, member_name) std::string_view(#member_name)
+
+// The operation to apply: &StructName::member
+#define OBJ_MEMBER_POINTER(struct_name, member_name) &struct_name::member_name
+
+// The operation to apply: declared type of StructName::member
+#define OBJ_MEMBER_TYPE(struct_name, member_name) decltype(struct_name::member_name)
+
+// --- Field metadata shared by DEFINE_STRUCT_OPERATORS and DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE ---
+#define DEFINE_STRUCT_FIELDS(StructName, ...) \
+    static constexpr std::string_view type_name() { \
+        return #StructName; \
+    } \
+    \
+    static constexpr auto field_names() { \
+        return std::array<std::string_view, PP_NARG(__VA_ARGS__)>{ APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_NAME, StructName, __VA_ARGS__) }; \
+    } \
+    \
+    template<typename Self = StructName> \
+    static constexpr auto field_pointers() { \
+        return std::make_tuple(APPLY_OP_TO_EACH_MEMBER(OBJ_MEMBER_POINTER, Self, __VA_ARGS__)); \
+    }
+
+template<typename T>
+struct struct_access_traits;
+
+namespace dmopex {
+    namespace fields_detail {
+        // Field metadata generated inside the struct by DEFINE_STRUCT_OPERATORS
+        template<typename T, typename = void>
+        struct intrusive_source : std::false_type {};
+
+        template<typename T>
+        struct intrusive_source<T, std::void_t<decltype(T::field_pointers())>> : std::true_type {
+            static constexpr auto names() { return T::field_names(); }
+            static constexpr auto pointers() { return T::field_pointers(); }
+        };
+
+        // Field metadata generated in struct_access_traits<T> by DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE
+        template<typename T, typename = void>
+        struct traits_source : std::false_type {};
+
+        template<typename T>
+        struct traits_source<T, std::void_t<decltype(::struct_access_traits<T>::field_pointers())>> : std::true_type {
+            static constexpr auto names() { return ::struct_access_traits<T>::field_names(); }
+            static constexpr auto pointers() { return ::struct_access_traits<T>::field_pointers(); }
+        };
+
+        template<typename T>
+        using source = std::conditional_t<intrusive_source<T>::value, intrusive_source<T>, traits_source<T>>;
+
+        template<typename Pointer>
+        struct member_pointer;
+
+        template<typename C, typename M>
+        struct member_pointer<M C::*> {
+            using class_type = C;
+            using member_type = M;
+        };
+
+        template<typename T, typename Pointers>
+        struct member_types;
+
+        template<typename T, typename... M>
+        struct member_types<T, std::tuple<M T::*...>> {
+            using type = std::tuple<M...>;
+        };
+    } // namespace fields_detail
+
+    // True for every struct registered with either macro
+    template<typename T>
+    inline constexpr bool is_reflected_v = fields_detail::source<std::remove_cv_t<T>>::value;
+
+    // Compile-time member metadata: names, member pointers and member types, in declaration order
+    template<typename T, typename = void>
+    struct fields {};
+
+    template<typename T>
+    struct fields<T, std::enable_if_t<fields_detail::source<T>::value>> {
+        static constexpr auto names = fields_detail::source<T>::names();
+        static constexpr auto pointers = fields_detail::source<T>::pointers();
+        static constexpr std::size_t size = names.size();
+
+        using types = typename fields_detail::member_types<T, std::decay_t<decltype(pointers)>>::type;
+
+        template<std::size_t I>
+        using type = std::tuple_element_t<I, types>;
+
+        // Index of the member called `name`, or `size` when there is none
+        static constexpr std::size_t index_of(std::string_view name) noexcept {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (names[i] == name) {
+                    return i;
+                }
+            }
+            return size;
+        }
+    };
+
+    // Reference to the I-th member of a reflected struct
+    template<std::size_t I, typename T>
+    constexpr decltype(auto) get(T& obj) noexcept {
+        return obj.*std::get<I>(fields<std::remove_cv_t<T>>::pointers);
+    }
+
+    namespace fields_detail {
+        template<typename T, typename F, std::size_t... I>
+        constexpr void for_each_field_impl(T& obj, F&& f, std::index_sequence<I...>) {
+            using meta = fields<std::remove_cv_t<T>>;
+            (f(meta::names[I], obj.*std::get<I>(meta::pointers)), ...);
+        }
+    } // namespace fields_detail
+
+    // Calls f(name, member) for each member in declaration order
+    template<typename T, typename F>
+    constexpr void for_each_field(T& obj, F&& f) {
+        constexpr auto size = fields<std::remove_cv_t<T>>::size;
+        fields_detail::for_each_field_impl(obj, std::forward<F>(f), std::make_index_sequence<size>{});
+    }
+
+    // Chain of member pointers leading to a possibly nested member: obj.*P1.*P2...
+    template<auto... P>
+    struct field_path {
+        static constexpr std::size_t depth = sizeof...(P);
+
+        template<typename T>
+        static constexpr auto& get(T& obj) noexcept {
+            return (obj .* ... .* P);
+        }
+    };
+
+    namespace fields_detail {
+        template<typename M, typename Path, bool = is_reflected_v<M>>
+        struct leaves_of {
+            using type = std::tuple<Path>;
+        };
+
+        template<typename M, auto... Prefix>
+        struct leaves_of<M, field_path<Prefix...>, true> {
+            template<std::size_t... I>
+            static auto expand(std::index_sequence<I...>) -> decltype(std::tuple_cat(std::declval<
+                typename leaves_of<typename fields<M>::template type<I>, field_path<Prefix..., std::get<I>(fields<M>::pointers)>>::type>()...));
+
+            using type = decltype(expand(std::make_index_sequence<fields<M>::size>{}));
+        };
+    } // namespace fields_detail
+
+    // Paths to the non-reflected members of T, nested reflected members flattened in declaration order:
+    // Transform { Vector3D pos; Color tint; } -> pos.x, pos.y, pos.z, tint.r, tint.g, tint.b, tint.a
+    template<typename T>
+    using leaf_fields_t = typename fields_detail::leaves_of<T, field_path<>>::type;
+
+    template<typename T>
+    inline constexpr std::size_t leaf_count_v = std::tuple_size_v<leaf_fields_t<T>>;
+
+    namespace fields_detail {
+        // C arrays and std::array members, handled element by element
+        template<typename T>
+        struct array_traits {
+            static constexpr bool value = false;
+        };
+
+        template<typename E, std::size_t N>
+        struct array_traits<E[N]> {
+            static constexpr bool value = true;
+            static constexpr std::size_t size = N;
+            using element_type = E;
+        };
+
+        template<typename E, std::size_t N>
+        struct array_traits<std::array<E, N>> {
+            static constexpr bool value = true;
+            static constexpr std::size_t size = N;
+            using element_type = E;
+        };
+
+        template<typename T>
+        inline constexpr bool is_array_v = array_traits<std::remove_cv_t<T>>::value;
+
+        // Innermost element type of possibly nested arrays
+        template<typename T, bool = is_array_v<T>>
+        struct scalar_of {
+            using type = T;
+        };
+
+        template<typename T>
+        struct scalar_of<T, true> {
+            using type = typename scalar_of<typename array_traits<std::remove_cv_t<T>>::element_type>::type;
+        };
+
+        // Member-wise equality that recurses into reflected members and arrays
+        template<typename T>
+        constexpr bool equal(const T& a, const T& b);
+
+        template<typename T, std::size_t... I>
+        constexpr bool equal_members(const T& a, const T& b, std::index_sequence<I...>) {
+            return (fields_detail::equal(dmopex::get<I>(a), dmopex::get<I>(b)) && ...);
+        }
+
+        template<typename T>
+        constexpr bool equal(const T& a, const T& b) {
+            if constexpr (is_reflected_v<T>) {
+                return fields_detail::equal_members(a, b, std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (is_array_v<T>) {
+                for (std::size_t k = 0; k < array_traits<std::remove_cv_t<T>>::size; ++k) {
+                    if (!fields_detail::equal(a[k], b[k])) {
+                        return false;
+                    }
+                }
+                return true;
+            } else {
+                return a == b;
+            }
+        }
+
+        // Expr<T>::value when Expr<T> is well-formed, false otherwise: noexcept checks that
+        // stay valid for types lacking the operation
+        template<template<typename> class Expr, typename T, typename = void>
+        struct nothrow_expr : std::false_type {};
+
+        template<template<typename> class Expr, typename T>
+        struct nothrow_expr<Expr, T, std::void_t<Expr<T>>> : std::bool_constant<Expr<T>::value> {};
+
+        template<typename T>
+        using equal_noexcept = std::bool_constant<noexcept(std::declval<const T&>() == std::declval<const T&>())>;
+
+        // Whether equal(a, b) cannot throw: every leaf's operator== is noexcept
+        template<typename T>
+        constexpr bool nothrow_equal();
+
+        template<typename T, std::size_t... I>
+        constexpr bool nothrow_equal_members(std::index_sequence<I...>) {
+            return (fields_detail::nothrow_equal<std::remove_cv_t<typename fields<T>::template type<I>>>() && ...);
+        }
+
+        template<typename... M>
+        inline constexpr bool nothrow_equal_v = (fields_detail::nothrow_equal<std::remove_cv_t<M>>() && ...);
+
+        template<typename T>
+        constexpr bool nothrow_equal() {
+            if constexpr (is_reflected_v<T>) {
+                return fields_detail::nothrow_equal_members<T>(std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (is_array_v<T>) {
+                return fields_detail::nothrow_equal<typename array_traits<std::remove_cv_t<T>>::element_type>();
+            } else {
+                return nothrow_expr<equal_noexcept, T>::value;
+            }
+        }
+
+        template<typename Tuple1, typename Tuple2, std::size_t... I>
+        constexpr bool tuple_equal_impl(const Tuple1& t1, const Tuple2& t2, std::index_sequence<I...>) {
+            return (fields_detail::equal(std::get<I>(t1), std::get<I>(t2)) && ...);
+        }
+
+        template<typename Tuple1, typename Tuple2>
+        constexpr bool tuple_equal(const Tuple1& t1, const Tuple2& t2) {
+            return fields_detail::tuple_equal_impl(t1, t2, std::make_index_sequence<std::tuple_size_v<Tuple1>>{});
+        }
+
+        // f(leaf...) for every leaf of the values in declaration order, recursing into reflected
+        // members and arrays
+        template<typename F, typename T, typename... In>
+        constexpr void visit(F& f, const T& first, const In&... in);
+
+        template<std::size_t I, typename F, typename T, typename... In>
+        constexpr void visit_member(F& f, const T& first, const In&... in) {
+            fields_detail::visit(f, dmopex::get<I>(first), dmopex::get<I>(in)...);
+        }
+
+        template<typename F, typename T, std::size_t... I, typename... In>
+        constexpr void visit_members(F& f, std::index_sequence<I...>, const T& first, const In&... in) {
+            (fields_detail::visit_member<I>(f, first, in...), ...);
+        }
+
+        template<typename F, typename T, typename... In>
+        constexpr void visit(F& f, const T& first, const In&... in) {
+            if constexpr (is_reflected_v<T>) {
+                fields_detail::visit_members(f, std::make_index_sequence<fields<T>::size>{}, first, in...);
+            } else if constexpr (is_array_v<T>) {
+                for (std::size_t k = 0; k < array_traits<std::remove_cv_t<T>>::size; ++k) {
+                    fields_detail::visit(f, first[k], in[k]...);
+                }
+            } else {
+                f(first, in...);
+            }
+        }
+
+        // out = f(in...) leaf by leaf, the same traversal writing the leaves of out
+        template<typename F, typename T, typename... In>
+        constexpr void zip(F& f, T& out, const In&... in);
+
+        template<std::size_t I, typename F, typename T, typename... In>
+        constexpr void zip_member(F& f, T& out, const In&... in) {
+            fields_detail::zip(f, dmopex::get<I>(out), dmopex::get<I>(in)...);
+        }
+
+        template<typename F, typename T, std::size_t... I, typename... In>
+        constexpr void zip_members(F& f, T& out, std::index_sequence<I...>, const In&... in) {
+            (fields_detail::zip_member<I>(f, out, in...), ...);
+        }
+
+        template<typename F, typename T, typename... In>
+        constexpr void zip(F& f, T& out, const In&... in) {
+            if constexpr (is_reflected_v<T>) {
+                fields_detail::zip_members(f, out, std::make_index_sequence<fields<T>::size>{}, in...);
+            } else if constexpr (is_array_v<T>) {
+                for (std::size_t k = 0; k < array_traits<std::remove_cv_t<T>>::size; ++k) {
+                    fields_detail::zip(f, out[k], in[k]...);
+                }
+            } else {
+                out = f(in...);
+            }
+        }
+
+        // Writes value the way operator<< of a reflected struct does, recursing into reflected
+        // members; arrays are written as [1, 2, 3], int8_t and uint8_t as numbers
+        template<typename Stream, typename T>
+        void print_value(Stream& os, const T& value);
+
+        template<typename Stream, typename T, std::size_t... I>
+        void print_members(Stream& os, const T& obj, std::index_sequence<I...>) {
+            os << "(";
+            ((os << (I == 0 ? "" : ", "), fields_detail::print_value(os, dmopex::get<I>(obj))), ...);
+            os << ")";
+        }
+
+        template<typename Stream, typename T>
+        void print_value(Stream& os, const T& value) {
+            if constexpr (is_reflected_v<T>) {
+                fields_detail::print_members(os, value, std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (is_array_v<T>) {
+                os << "[";
+                for (std::size_t k = 0; k < array_traits<std::remove_cv_t<T>>::size; ++k) {
+                    os << (k == 0 ? "" : ", ");
+                    fields_detail::print_value(os, value[k]);
+                }
+                os << "]";
+            } else if constexpr (std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+                // int8_t / uint8_t members are numbers, not characters
+                os << static_cast<int>(value);
+            } else {
+                os << value;
+            }
+        }
+    } // namespace fields_detail
+} // namespace dmopex
+
+#endif // __DMOPEX_FIELDS_H_INCLUDE__
@@ -0,0 +1,57 @@
+﻿#ifndef __DMOPEX_HASH_H_INCLUDE__
+#define __DMOPEX_HASH_H_INCLUDE__
+
+#include <cstddef>
+#include <utility>
+#include <functional>
+
+#include "dmopex_fields.h"
+
+// Member-wise hashing for reflected structs:
+//
+//   std::size_t h = dmopex::hash(p);
+//   std::unordered_set<Point2D, dmopex::hasher> points;
+
+namespace dmopex {
+    template<typename T>
+    std::size_t hash(const T& value);
+
+    namespace hash_detail {
+        constexpr std::size_t combine(std::size_t seed, std::size_t h) noexcept {
+            return seed ^ (h + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+        }
+
+        template<typename T, std::size_t... I>
+        std::size_t hash_struct(const T& obj, std::index_sequence<I...>) {
+            std::size_t seed = 0;
+            ((seed = hash_detail::combine(seed, dmopex::hash(dmopex::get<I>(obj)))), ...);
+            return seed;
+        }
+    } // namespace hash_detail
+
+    // Reflected structs combine the hashes of their members in declaration order, arrays
+    // the hashes of their elements, anything else goes to std::hash
+    template<typename T>
+    std::size_t hash(const T& value) {
+        if constexpr (is_reflected_v<T>) {
+            return hash_detail::hash_struct(value, std::make_index_sequence<fields<T>::size>{});
+        } else if constexpr (fields_detail::is_array_v<T>) {
+            std::size_t seed = 0;
+            for (std::size_t k = 0; k < fields_detail::array_traits<T>::size; ++k) {
+                seed = hash_detail::combine(seed, dmopex::hash(value[k]));
+            }
+            return seed;
+        } else {
+            return std::hash<T>{}(value);
+        }
+    }
+
+    struct hasher {
+        template<typename T>
+        std::size_t operator()(const T& value) const {
+            return dmopex::hash(value);
+        }
+    };
+} // namespace dmopex
+
+#endif // __DMOPEX_HASH_H_INCLUDE__
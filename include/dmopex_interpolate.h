@@ -0,0 +1,267 @@
+﻿#ifndef __DMOPEX_INTERPOLATE_H_INCLUDE__
+#define __DMOPEX_INTERPOLATE_H_INCLUDE__
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_batch.h"
+
+// Member-wise interpolation in a single pass, without the temporaries of a + (b - a) * t:
+//
+//   Vector3D p = dmopex::lerp(from, to, 0.25f);
+//   Vector3D q = dmopex::nlerp(q0, q1, t);              // lerp, then normalized to unit length
+//   Vector3D h = dmopex::hermite(p0, m0, p1, m1, t);    // cubic Hermite, m0 / m1 tangents
+//   Vector3D c = dmopex::bezier(p0, p1, p2, p3, t);     // cubic Bezier
+//   dmopex::batch_lerp<Vector3D>(a, b, t, out);         // out[i] = lerp(a[i], b[i], t[i])
+//
+// Works on reflected structs (nested members and arrays included), arrays and plain
+// arithmetic values. Integer members are computed in the type of t, rounded to nearest and
+// saturated to the range of the member.
+// The batch versions vectorize over plain floating-point arrays, so a structure-of-arrays
+// layout interpolated one column at a time gets vector code; arrays of structs go element
+// by element with the weights computed once per element.
+
+namespace dmopex {
+    namespace interp_detail {
+        // Keeps t out of template argument deduction, so a std::vector<float> converts to span<const S>
+        template<typename S>
+        using t_span = span<const typename std::enable_if<std::is_floating_point_v<S>, S>::type>;
+
+        // Type a leaf M is computed in: the wider of M and S for floating-point leaves, S for integers
+        template<typename M, typename S>
+        using compute_t = std::conditional_t<std::is_floating_point_v<M>, std::common_type_t<M, S>, S>;
+
+        // Converts a result computed in S back to the leaf type M. Integers saturate: Hermite and
+        // Bezier overshoot the control points, and lerp does for t outside [0, 1]
+        template<typename M, typename S>
+        constexpr M to_leaf(S v) {
+            if constexpr (std::is_integral_v<M>) {
+                constexpr S low = static_cast<S>(std::numeric_limits<M>::lowest());
+                constexpr S high = static_cast<S>((std::numeric_limits<M>::max)()); // may round up to max + 1
+                const S rounded = v < 0 ? v - S(0.5) : v + S(0.5);
+                if (!(rounded > low)) {
+                    return std::numeric_limits<M>::lowest();
+                }
+                if (rounded >= high) {
+                    return (std::numeric_limits<M>::max)();
+                }
+                return static_cast<M>(rounded);
+            } else {
+                return static_cast<M>(v);
+            }
+        }
+
+        // Leaf kernels hold the weights derived from t once per interpolated value
+        template<typename S>
+        struct lerp_leaf {
+            static constexpr std::size_t weight_count = 1;
+            S w[1];
+
+            template<typename M>
+            constexpr M operator()(const M& a, const M& b) const {
+                using C = compute_t<M, S>;
+                return interp_detail::to_leaf<M>(C(a) + (C(b) - C(a)) * C(w[0]));
+            }
+        };
+
+        // Sum of w[k] * x[k]
+        template<typename S, std::size_t N>
+        struct weighted_leaf {
+            static constexpr std::size_t weight_count = N;
+            S w[N];
+
+            template<typename M, typename... X>
+            constexpr M operator()(const M& x0, const X&... xs) const {
+                return apply(std::make_index_sequence<N>{}, x0, xs...);
+            }
+
+        private:
+            template<std::size_t... I, typename M, typename... X>
+            constexpr M apply(std::index_sequence<I...>, const M& x0, const X&... xs) const {
+                using C = compute_t<M, S>;
+                const M x[N] = { x0, xs... };
+                return interp_detail::to_leaf<M>(((C(w[I]) * C(x[I])) + ...));
+            }
+        };
+
+        template<typename S>
+        constexpr weighted_leaf<S, 4> hermite_weights(S t) {
+            const S t2 = t * t;
+            const S t3 = t2 * t;
+            return { { 2 * t3 - 3 * t2 + 1, t3 - 2 * t2 + t, -2 * t3 + 3 * t2, t3 - t2 } };
+        }
+
+        template<typename S>
+        constexpr weighted_leaf<S, 4> bezier_weights(S t) {
+            const S u = 1 - t;
+            return { { u * u * u, 3 * u * u * t, 3 * u * t * t, t * t * t } };
+        }
+
+        struct squared_sum {
+            double sum = 0;
+
+            template<typename M>
+            M operator()(const M& v) {
+                sum += double(v) * double(v);
+                return v;
+            }
+        };
+
+        // Whether every leaf of T, through reflected members and arrays, is floating point
+        template<typename T, typename = void>
+        struct floating_leaves : std::is_floating_point<T> {};
+
+        template<typename T>
+        struct floating_leaves<T, std::enable_if_t<fields_detail::is_array_v<T>>>
+            : floating_leaves<typename fields_detail::array_traits<T>::element_type> {};
+
+        template<typename T>
+        struct floating_leaves<T, std::enable_if_t<is_reflected_v<T>>> {
+            template<std::size_t... I>
+            static constexpr bool all(std::index_sequence<I...>) {
+                return (floating_leaves<typename fields<T>::template type<I>>::value && ...);
+            }
+
+            static constexpr bool value = all(std::make_index_sequence<fields<T>::size>{});
+        };
+
+        template<typename S>
+        struct scale_leaf {
+            S factor;
+
+            template<typename M>
+            M operator()(const M& v) const { return static_cast<M>(v * factor); }
+        };
+
+        // Element types processed as a plain array: one floating-point value per element,
+        // a floating-point column of a structure of arrays or a struct wrapping one
+        template<typename T, typename = void>
+        struct flat {
+            static constexpr bool value = false;
+        };
+
+        template<typename T>
+        struct flat<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+            static constexpr bool value = true;
+            using leaf_type = T;
+        };
+
+        template<typename T>
+        struct flat<T, std::enable_if_t<is_reflected_v<T>>> {
+            using leaf_type = typename batch_detail::flat_layout<T>::leaf_type;
+            static constexpr bool value = batch_detail::flat_layout<T>::value &&
+                std::is_floating_point_v<leaf_type> && sizeof(T) == sizeof(leaf_type);
+        };
+
+        template<typename L, typename Leaf, std::size_t N, std::size_t... I>
+        inline L flat_leaf(const Leaf& leaf, const L* const (&src)[N], std::size_t at, std::index_sequence<I...>) {
+            return leaf(src[I][at]...);
+        }
+
+        // Plain arrays of one floating-point type: fixed-size blocks keep the inner loop free
+        // of trip-count checks, so it vectorizes even under the cheap cost model of -O2
+        template<typename L, typename S, typename Kernel, std::size_t N>
+        void flat_map(const S* t, L* z, const L* const (&src)[N], std::size_t n, Kernel kernel) {
+            constexpr std::size_t block = 16;
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                DMOPEX_IVDEP
+                for (std::size_t e = 0; e < block; ++e) {
+                    z[i + e] = interp_detail::flat_leaf(kernel(t[i + e]), src, i + e, std::make_index_sequence<N>{});
+                }
+            }
+            for (; i < n; ++i) {
+                z[i] = interp_detail::flat_leaf(kernel(t[i]), src, i, std::make_index_sequence<N>{});
+            }
+        }
+
+        // out[i] = in[i]... combined leaf by leaf by kernel(t[i])
+        template<typename T, typename S, typename Kernel, typename... In>
+        void batch_map(span<const S> t, span<T> out, Kernel kernel, span<const In>... in) {
+            assert(((in.size() == t.size()) && ...) && out.size() >= t.size());
+            const std::size_t n = t.size();
+            if constexpr (flat<T>::value) {
+                using L = typename flat<T>::leaf_type;
+                const L* const src[] = { reinterpret_cast<const L*>(in.data())... };
+                interp_detail::flat_map(t.data(), reinterpret_cast<L*>(out.data()), src, n, kernel);
+            } else {
+                // Weights computed once per element, the result built in a local copy and stored once
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto leaf = kernel(t[i]);
+                    T result = std::get<0>(std::tie(in[i]...));
+                    fields_detail::zip(leaf, result, in[i]...);
+                    out[i] = result;
+                }
+            }
+        }
+    } // namespace interp_detail
+
+    template<typename T, typename S>
+    constexpr T lerp(const T& a, const T& b, S t) {
+        static_assert(std::is_floating_point_v<S>, "dmopex::lerp takes a floating-point t");
+        T result = a;
+        interp_detail::lerp_leaf<S> leaf{ { t } };
+        fields_detail::zip(leaf, result, a, b);
+        return result;
+    }
+
+    // lerp scaled to unit length over all leaves (floating-point leaves only), e.g. for quaternions
+    template<typename T, typename S>
+    T nlerp(const T& a, const T& b, S t) {
+        static_assert(interp_detail::floating_leaves<T>::value, "dmopex::nlerp normalizes floating-point leaves only");
+        T result = dmopex::lerp(a, b, t);
+        interp_detail::squared_sum squares;
+        fields_detail::zip(squares, result, result);
+        if (squares.sum > 0) {
+            interp_detail::scale_leaf<S> scale{ static_cast<S>(1 / std::sqrt(squares.sum)) };
+            fields_detail::zip(scale, result, result);
+        }
+        return result;
+    }
+
+    // Cubic Hermite spline through p0 and p1 with tangents m0 and m1
+    template<typename T, typename S>
+    constexpr T hermite(const T& p0, const T& m0, const T& p1, const T& m1, S t) {
+        static_assert(std::is_floating_point_v<S>, "dmopex::hermite takes a floating-point t");
+        T result = p0;
+        auto leaf = interp_detail::hermite_weights(t);
+        fields_detail::zip(leaf, result, p0, m0, p1, m1);
+        return result;
+    }
+
+    // Cubic Bezier curve with control points p0..p3
+    template<typename T, typename S>
+    constexpr T bezier(const T& p0, const T& p1, const T& p2, const T& p3, S t) {
+        static_assert(std::is_floating_point_v<S>, "dmopex::bezier takes a floating-point t");
+        T result = p0;
+        auto leaf = interp_detail::bezier_weights(t);
+        fields_detail::zip(leaf, result, p0, p1, p2, p3);
+        return result;
+    }
+
+    // Batch versions: one t per element (float unless given, batch_lerp<Quat, double>),
+    // out may be the same array as an input
+    template<typename T, typename S = float>
+    void batch_lerp(span<const T> a, span<const T> b, interp_detail::t_span<S> t, span<T> out) {
+        interp_detail::batch_map(t, out, [](auto w) { return interp_detail::lerp_leaf<decltype(w)>{ { w } }; }, a, b);
+    }
+
+    template<typename T, typename S = float>
+    void batch_hermite(span<const T> p0, span<const T> m0, span<const T> p1, span<const T> m1, interp_detail::t_span<S> t, span<T> out) {
+        interp_detail::batch_map(t, out, [](auto w) { return interp_detail::hermite_weights(w); }, p0, m0, p1, m1);
+    }
+
+    template<typename T, typename S = float>
+    void batch_bezier(span<const T> p0, span<const T> p1, span<const T> p2, span<const T> p3, interp_detail::t_span<S> t, span<T> out) {
+        interp_detail::batch_map(t, out, [](auto w) { return interp_detail::bezier_weights(w); }, p0, p1, p2, p3);
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_INTERPOLATE_H_INCLUDE__
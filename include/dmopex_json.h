@@ -0,0 +1,456 @@
+﻿#ifndef __DMOPEX_JSON_H_INCLUDE__
+#define __DMOPEX_JSON_H_INCLUDE__
+
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "dmopex_fields.h"
+#include "dmopex_parse.h"
+
+// DOM-free JSON for reflected structs. Objects are written member by member straight
+// into a std::string and read back in a single pass over the input:
+//
+//   std::string json = dmopex::to_json(p);                 // {"x":1.5,"y":2.5}
+//   dmopex::parse_status status = dmopex::from_json(json, p);
+//
+// Supported members: arithmetic types, bool, std::string, reflected structs,
+// std::array, C arrays and std::vector of any of those.
+
+namespace dmopex {
+    namespace json_detail {
+        template<typename T>
+        struct is_vector : std::false_type {};
+
+        template<typename T, typename A>
+        struct is_vector<std::vector<T, A>> : std::true_type {};
+
+        template<typename T>
+        struct is_std_array : std::false_type {};
+
+        template<typename T, std::size_t N>
+        struct is_std_array<std::array<T, N>> : std::true_type {};
+
+        // "name": for the first member, ,"name": for the others
+        template<typename T, std::size_t I>
+        struct quoted_key {
+            static constexpr std::string_view name = fields<T>::names[I];
+            static constexpr std::size_t prefix = I == 0 ? 0 : 1;
+            static constexpr std::size_t length = prefix + name.size() + 3;
+
+            static constexpr std::array<char, length> make() {
+                std::array<char, length> key{};
+                if (prefix) {
+                    key[0] = ',';
+                }
+                key[prefix] = '"';
+                for (std::size_t i = 0; i < name.size(); ++i) {
+                    key[prefix + 1 + i] = name[i];
+                }
+                key[length - 2] = '"';
+                key[length - 1] = ':';
+                return key;
+            }
+
+            static constexpr std::array<char, length> text = make();
+        };
+
+        // --- writer ---
+
+        inline void write_string(std::string& out, std::string_view str) {
+            static const char hex[] = "0123456789abcdef";
+            out.push_back('"');
+            std::size_t run = 0;
+            for (std::size_t i = 0; i < str.size(); ++i) {
+                unsigned char c = static_cast<unsigned char>(str[i]);
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                out.append(str.data() + run, i - run);
+                run = i + 1;
+                out.push_back('\\');
+                switch (c) {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '\b': out.push_back('b'); break;
+                case '\f': out.push_back('f'); break;
+                case '\n': out.push_back('n'); break;
+                case '\r': out.push_back('r'); break;
+                case '\t': out.push_back('t'); break;
+                default:
+                    out.append("u00");
+                    out.push_back(hex[c >> 4]);
+                    out.push_back(hex[c & 0xF]);
+                    break;
+                }
+            }
+            out.append(str.data() + run, str.size() - run);
+            out.push_back('"');
+        }
+
+        template<typename T>
+        void write_value(std::string& out, const T& value);
+
+        template<typename T, std::size_t I>
+        void write_member(std::string& out, const T& obj) {
+            using key = quoted_key<T, I>;
+            out.append(key::text.data(), key::length);
+            json_detail::write_value(out, obj.*std::get<I>(fields<T>::pointers));
+        }
+
+        template<typename T, std::size_t... I>
+        void write_object(std::string& out, const T& obj, std::index_sequence<I...>) {
+            out.push_back('{');
+            (json_detail::write_member<T, I>(out, obj), ...);
+            out.push_back('}');
+        }
+
+        template<typename Range>
+        void write_array(std::string& out, const Range& range) {
+            out.push_back('[');
+            bool first = true;
+            for (const auto& item : range) {
+                if (!first) {
+                    out.push_back(',');
+                }
+                first = false;
+                json_detail::write_value(out, item);
+            }
+            out.push_back(']');
+        }
+
+        template<typename T>
+        void write_value(std::string& out, const T& value) {
+            if constexpr (is_reflected_v<T>) {
+                json_detail::write_object(out, value, std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (std::is_same_v<T, bool>) {
+                out.append(value ? "true" : "false");
+            } else if constexpr (std::is_floating_point_v<T>) {
+                if (value != value || value == std::numeric_limits<T>::infinity() || value == -std::numeric_limits<T>::infinity()) {
+                    out.append("null");
+                    return;
+                }
+                char text[64];
+                auto result = std::to_chars(text, text + sizeof(text), value);
+                out.append(text, static_cast<std::size_t>(result.ptr - text));
+            } else if constexpr (std::is_integral_v<T>) {
+                char text[24];
+                auto result = std::to_chars(text, text + sizeof(text), value);
+                out.append(text, static_cast<std::size_t>(result.ptr - text));
+            } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                json_detail::write_string(out, value);
+            } else if constexpr (std::is_array_v<T> || is_std_array<T>::value || is_vector<T>::value) {
+                json_detail::write_array(out, value);
+            } else {
+                static_assert(is_reflected_v<T>, "unsupported member type for dmopex JSON");
+            }
+        }
+
+        // --- reader ---
+
+        using parse_detail::cursor;
+        using parse_detail::skip_space;
+        using parse_detail::expect;
+
+        inline bool consume(cursor& cur, char c) noexcept {
+            skip_space(cur);
+            if (cur.it != cur.end && *cur.it == c) {
+                ++cur.it;
+                return true;
+            }
+            return false;
+        }
+
+        inline bool consume_literal(cursor& cur, std::string_view literal) noexcept {
+            skip_space(cur);
+            if (static_cast<std::size_t>(cur.end - cur.it) >= literal.size() &&
+                std::string_view(cur.it, literal.size()) == literal) {
+                cur.it += literal.size();
+                return true;
+            }
+            return false;
+        }
+
+        // Raw text between the quotes, escapes left in place
+        inline bool read_raw_string(cursor& cur, std::string_view& raw) noexcept {
+            if (!expect(cur, '"')) {
+                return false;
+            }
+            const char* begin = cur.it;
+            while (cur.it != cur.end && *cur.it != '"') {
+                if (*cur.it == '\\' && cur.end - cur.it > 1) {
+                    ++cur.it;
+                }
+                ++cur.it;
+            }
+            if (cur.it == cur.end) {
+                return cur.fail(std::errc::invalid_argument, cur.it);
+            }
+            raw = std::string_view(begin, static_cast<std::size_t>(cur.it - begin));
+            ++cur.it;
+            return true;
+        }
+
+        inline bool read_hex4(cursor& cur, const char* p, unsigned& code) noexcept {
+            if (cur.end - p < 4) {
+                return cur.fail(std::errc::invalid_argument, p);
+            }
+            auto result = std::from_chars(p, p + 4, code, 16);
+            if (result.ptr != p + 4) {
+                return cur.fail(std::errc::invalid_argument, p);
+            }
+            return true;
+        }
+
+        inline void append_utf8(std::string& out, unsigned code) {
+            if (code < 0x80) {
+                out.push_back(static_cast<char>(code));
+            } else if (code < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            } else if (code < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+
+        inline bool read_string(cursor& cur, std::string& value) {
+            std::string_view raw;
+            if (!read_raw_string(cur, raw)) {
+                return false;
+            }
+            value.clear();
+            for (const char* p = raw.data(); p != raw.data() + raw.size(); ++p) {
+                if (*p != '\\') {
+                    value.push_back(*p);
+                    continue;
+                }
+                ++p;
+                switch (*p) {
+                case '"': value.push_back('"'); break;
+                case '\\': value.push_back('\\'); break;
+                case '/': value.push_back('/'); break;
+                case 'b': value.push_back('\b'); break;
+                case 'f': value.push_back('\f'); break;
+                case 'n': value.push_back('\n'); break;
+                case 'r': value.push_back('\r'); break;
+                case 't': value.push_back('\t'); break;
+                case 'u': {
+                    unsigned code = 0;
+                    if (!read_hex4(cur, p + 1, code)) {
+                        return false;
+                    }
+                    p += 4;
+                    if (code >= 0xD800 && code < 0xDC00 && raw.data() + raw.size() - p > 6 && p[1] == '\\' && p[2] == 'u') {
+                        unsigned low = 0;
+                        if (!read_hex4(cur, p + 3, low)) {
+                            return false;
+                        }
+                        if (low >= 0xDC00 && low < 0xE000) {
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                            p += 6;
+                        }
+                    }
+                    append_utf8(value, code);
+                    break;
+                }
+                default:
+                    return cur.fail(std::errc::invalid_argument, p - 1);
+                }
+            }
+            return true;
+        }
+
+        // Skips any JSON value (used for unknown keys)
+        inline bool skip_value(cursor& cur, int depth = 0) {
+            skip_space(cur);
+            if (cur.it == cur.end || depth > 512) {
+                return cur.fail(std::errc::invalid_argument, cur.it);
+            }
+            char c = *cur.it;
+            if (c == '"') {
+                std::string_view raw;
+                return read_raw_string(cur, raw);
+            }
+            if (c == '{' || c == '[') {
+                const char close = c == '{' ? '}' : ']';
+                ++cur.it;
+                if (consume(cur, close)) {
+                    return true;
+                }
+                do {
+                    if (c == '{') {
+                        std::string_view key;
+                        if (!read_raw_string(cur, key) || !expect(cur, ':')) {
+                            return false;
+                        }
+                    }
+                    if (!skip_value(cur, depth + 1)) {
+                        return false;
+                    }
+                } while (consume(cur, ','));
+                return expect(cur, close);
+            }
+            if (consume_literal(cur, "true") || consume_literal(cur, "false") || consume_literal(cur, "null")) {
+                return true;
+            }
+            double number = 0;
+            auto result = std::from_chars(cur.it, cur.end, number);
+            if (result.ec == std::errc::invalid_argument) {
+                return cur.fail(result.ec, cur.it);
+            }
+            cur.it = result.ptr;
+            return true;
+        }
+
+        template<typename T>
+        bool read_value(cursor& cur, T& value);
+
+        template<typename T, std::size_t... I>
+        bool read_member_at(cursor& cur, T& obj, std::size_t index, std::index_sequence<I...>) {
+            bool ok = false;
+            ((index == I ? (ok = json_detail::read_value(cur, obj.*std::get<I>(fields<T>::pointers)), true) : false) || ...);
+            return ok;
+        }
+
+        template<typename T>
+        bool read_object(cursor& cur, T& obj) {
+            using meta = fields<T>;
+            if (!expect(cur, '{')) {
+                return false;
+            }
+            if (consume(cur, '}')) {
+                return true;
+            }
+            std::size_t expected = 0;
+            do {
+                std::string_view key;
+                if (!read_raw_string(cur, key) || !expect(cur, ':')) {
+                    return false;
+                }
+                // Keys in declaration order hit on the first comparison
+                std::size_t index = expected < meta::size && meta::names[expected] == key ? expected : meta::index_of(key);
+                if (index == meta::size) {
+                    if (!skip_value(cur)) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (!json_detail::read_member_at(cur, obj, index, std::make_index_sequence<meta::size>{})) {
+                    return false;
+                }
+                expected = index + 1;
+            } while (consume(cur, ','));
+            return expect(cur, '}');
+        }
+
+        template<typename Element>
+        bool read_fixed_array(cursor& cur, Element* data, std::size_t size) {
+            if (!expect(cur, '[')) {
+                return false;
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                if ((i != 0 && !expect(cur, ',')) || !json_detail::read_value(cur, data[i])) {
+                    return false;
+                }
+            }
+            return expect(cur, ']');
+        }
+
+        template<typename T>
+        bool read_value(cursor& cur, T& value) {
+            if constexpr (is_reflected_v<T>) {
+                return json_detail::read_object(cur, value);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                if (consume_literal(cur, "true")) {
+                    value = true;
+                    return true;
+                }
+                if (consume_literal(cur, "false")) {
+                    value = false;
+                    return true;
+                }
+                return cur.fail(std::errc::invalid_argument, cur.it);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                skip_space(cur);
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (consume_literal(cur, "null")) {
+                        value = std::numeric_limits<T>::quiet_NaN();
+                        return true;
+                    }
+                }
+                auto result = std::from_chars(cur.it, cur.end, value);
+                if (result.ec != std::errc()) {
+                    return cur.fail(result.ec, cur.it);
+                }
+                cur.it = result.ptr;
+                return true;
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return json_detail::read_string(cur, value);
+            } else if constexpr (std::is_array_v<T>) {
+                return json_detail::read_fixed_array(cur, value, std::extent_v<T>);
+            } else if constexpr (is_std_array<T>::value) {
+                return json_detail::read_fixed_array(cur, value.data(), value.size());
+            } else if constexpr (is_vector<T>::value) {
+                value.clear();
+                if (!expect(cur, '[')) {
+                    return false;
+                }
+                if (consume(cur, ']')) {
+                    return true;
+                }
+                do {
+                    value.emplace_back();
+                    if (!json_detail::read_value(cur, value.back())) {
+                        return false;
+                    }
+                } while (consume(cur, ','));
+                return expect(cur, ']');
+            } else {
+                static_assert(is_reflected_v<T>, "unsupported member type for dmopex JSON");
+                return false;
+            }
+        }
+    } // namespace json_detail
+
+    // Appends the JSON object for obj to out
+    template<typename T>
+    void to_json(std::string& out, const T& obj) {
+        static_assert(is_reflected_v<T>, "dmopex::to_json requires a reflected struct");
+        json_detail::write_value(out, obj);
+    }
+
+    template<typename T>
+    std::string to_json(const T& obj) {
+        std::string out;
+        dmopex::to_json(out, obj);
+        return out;
+    }
+
+    // Reads a JSON object into obj. Unknown keys are skipped, missing keys leave the member untouched.
+    template<typename T>
+    parse_status from_json(std::string_view text, T& obj) {
+        static_assert(is_reflected_v<T>, "dmopex::from_json requires a reflected struct");
+        parse_detail::cursor cur{ text.data(), text.data(), text.data() + text.size(), std::errc() };
+        if (json_detail::read_value(cur, obj)) {
+            json_detail::skip_space(cur);
+            if (cur.it != cur.end) {
+                cur.fail(std::errc::invalid_argument, cur.it);
+            }
+        }
+        return parse_status{ cur.ec, static_cast<std::size_t>(cur.it - cur.begin), 0 };
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_JSON_H_INCLUDE__
@@ -0,0 +1,201 @@
+﻿#ifndef __DMOPEX_LAYOUT_H_INCLUDE__
+#define __DMOPEX_LAYOUT_H_INCLUDE__
+
+#include <new>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+#include "dmopex_fields.h"
+
+// Memory layout of reflected structs: member offsets, sizes and alignments, the bytes lost to
+// padding and the member order that needs the least:
+//
+//   static_assert(dmopex::layout<Particle>::padding == 0, "Particle is packed");
+//   dmopex::print_layout<Particle>(std::cout, "Particle");
+//
+//   DMOPEX_LAYOUT_REPORT(Particle)                 // at namespace scope, once per type
+//   dmopex::print_layout_reports(std::cout);       // every registered type, most padding first
+//
+// Only the registered members are counted: padding is sizeof(T) minus their sizes, so
+// members left out of the macro show up as padding. The suggested order sorts the members
+// by decreasing alignment, which leaves no padding between them; its size is what the
+// struct would take declared in that order.
+
+namespace dmopex {
+    struct member_layout {
+        std::string_view name;
+        std::size_t offset;
+        std::size_t size;
+        std::size_t align;
+    };
+
+    namespace layout_detail {
+        template<typename... M>
+        constexpr std::array<std::size_t, sizeof...(M)> sizes_of(std::tuple<M...>*) {
+            return { sizeof(M)... };
+        }
+
+        template<typename... M>
+        constexpr std::array<std::size_t, sizeof...(M)> aligns_of(std::tuple<M...>*) {
+            return { alignof(M)... };
+        }
+
+        template<std::size_t N>
+        constexpr std::size_t sum(const std::array<std::size_t, N>& values) {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                total += values[i];
+            }
+            return total;
+        }
+
+        // Member indices by decreasing alignment, declaration order among equal alignments
+        template<std::size_t N>
+        constexpr std::array<std::size_t, N> by_alignment(const std::array<std::size_t, N>& aligns) {
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; ++i) {
+                order[i] = i;
+            }
+            for (std::size_t i = 1; i < N; ++i) {
+                for (std::size_t j = i; j > 0 && aligns[order[j - 1]] < aligns[order[j]]; --j) {
+                    std::size_t t = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = t;
+                }
+            }
+            return order;
+        }
+
+        constexpr std::size_t round_up(std::size_t n, std::size_t align) {
+            return (n + align - 1) / align * align;
+        }
+
+        template<typename T, typename... Pointer>
+        std::array<std::size_t, sizeof...(Pointer)> offsets_in(const T& obj, Pointer... pointers) {
+            const unsigned char* base = reinterpret_cast<const unsigned char*>(&obj);
+            return { static_cast<std::size_t>(reinterpret_cast<const unsigned char*>(&(obj.*pointers)) - base)... };
+        }
+
+        // Same as offsetof, through the member pointers, measured on a real object: a
+        // value-initialized T, or for types without a default constructor the T that starts to
+        // live in suitably aligned bytes, which needs T trivially copyable. A member pointer
+        // gives no offset in a constant expression, hence the object and the run-time call.
+        template<typename T, std::size_t... I>
+        std::array<std::size_t, sizeof...(I)> offsets(std::index_sequence<I...>) {
+            if constexpr (std::is_default_constructible_v<T>) {
+                const T obj{};
+                return layout_detail::offsets_in(obj, std::get<I>(fields<T>::pointers)...);
+            } else {
+                static_assert(std::is_trivially_copyable_v<T>,
+                    "dmopex::layout<T>::members needs T default-constructible or trivially copyable");
+                alignas(T) unsigned char storage[sizeof(T)];
+                return layout_detail::offsets_in(*std::launder(reinterpret_cast<const T*>(storage)), std::get<I>(fields<T>::pointers)...);
+            }
+        }
+
+        template<typename T, std::size_t... I>
+        std::array<member_layout, sizeof...(I)> members(std::index_sequence<I...> order) {
+            const std::array<std::size_t, sizeof...(I)> offset = layout_detail::offsets<T>(order);
+            return { member_layout{ fields<T>::names[I], offset[I],
+                sizeof(typename fields<T>::template type<I>), alignof(typename fields<T>::template type<I>) }... };
+        }
+    } // namespace layout_detail
+
+    template<typename T>
+    struct layout {
+        static_assert(is_reflected_v<T>, "dmopex::layout requires a reflected struct");
+
+        static constexpr std::size_t size = sizeof(T);
+        static constexpr std::size_t align = alignof(T);
+        static constexpr std::size_t member_count = fields<T>::size;
+
+        static constexpr std::array<std::size_t, member_count> member_sizes =
+            layout_detail::sizes_of(static_cast<typename fields<T>::types*>(nullptr));
+        static constexpr std::array<std::size_t, member_count> member_aligns =
+            layout_detail::aligns_of(static_cast<typename fields<T>::types*>(nullptr));
+
+        // Bytes of the registered members, and everything else
+        static constexpr std::size_t member_bytes = layout_detail::sum(member_sizes);
+        static constexpr std::size_t padding = size - member_bytes;
+
+        static constexpr std::array<std::size_t, member_count> suggested_order = layout_detail::by_alignment(member_aligns);
+        static constexpr std::size_t suggested_size = layout_detail::round_up(member_bytes, align);
+
+        // Name, offset, size and alignment of every member in declaration order
+        static std::array<member_layout, member_count> members() {
+            return layout_detail::members<T>(std::make_index_sequence<member_count>{});
+        }
+    };
+
+    template<typename T>
+    void print_layout(std::ostream& os, std::string_view name) {
+        using L = layout<T>;
+        const auto members = L::members();
+        os << name << ": size " << L::size << ", align " << L::align << ", padding " << L::padding << " bytes";
+        if (L::padding != 0) {
+            const std::ios_base::fmtflags flags = os.flags();
+            const std::streamsize precision = os.precision();
+            os << " (" << std::fixed << std::setprecision(1) << 100.0 * L::padding / L::size << "%)";
+            os.flags(flags);
+            os.precision(precision);
+        }
+        os << "\n";
+        os << "  offset   size  align  member\n";
+        for (const member_layout& m : members) {
+            os << std::setw(8) << m.offset << std::setw(7) << m.size << std::setw(7) << m.align << "  " << m.name << "\n";
+        }
+        if (L::suggested_size < L::size) {
+            os << "  suggested order:";
+            for (std::size_t i : L::suggested_order) {
+                os << " " << members[i].name;
+            }
+            os << " -> size " << L::suggested_size << ", saves " << L::size - L::suggested_size << " bytes\n";
+        }
+    }
+
+    namespace layout_detail {
+        struct report {
+            std::string_view name;
+            std::size_t padding;
+            void (*print)(std::ostream&, std::string_view);
+        };
+
+        inline std::vector<report>& reports() {
+            static std::vector<report> registered;
+            return registered;
+        }
+
+        template<typename T>
+        struct registrar {
+            explicit registrar(std::string_view name) {
+                reports().push_back(report{ name, layout<T>::padding, &dmopex::print_layout<T> });
+            }
+        };
+    } // namespace layout_detail
+
+    // Report of every type registered with DMOPEX_LAYOUT_REPORT, the most padding first
+    inline void print_layout_reports(std::ostream& os) {
+        std::vector<layout_detail::report> sorted = layout_detail::reports();
+        std::stable_sort(sorted.begin(), sorted.end(), [](const layout_detail::report& a, const layout_detail::report& b) {
+            return a.padding > b.padding;
+        });
+        for (const layout_detail::report& r : sorted) {
+            r.print(os, r.name);
+            os << "\n";
+        }
+    }
+} // namespace dmopex
+
+// Registers a reflected type for dmopex::print_layout_reports, at namespace scope
+#define DMOPEX_LAYOUT_REPORT(StructName) \
+    static const dmopex::layout_detail::registrar<StructName> PASTE(dmopex_layout_report_, __LINE__){ #StructName };
+
+#endif // __DMOPEX_LAYOUT_H_INCLUDE__
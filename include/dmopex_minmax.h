@@ -0,0 +1,318 @@
+﻿#ifndef __DMOPEX_MINMAX_H_INCLUDE__
+#define __DMOPEX_MINMAX_H_INCLUDE__
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_batch.h"
+
+// Member-wise min, max, clamp and abs, and array-wide bounds:
+//
+//   Vector3D m = (dmopex::min)(a, b);                    // { min(a.x, b.x), ... }
+//   Color c = dmopex::clamp(color, Color{}, white);      // every channel into its range
+//   Vector3D d = dmopex::abs(v);
+//   dmopex::batch_clamp<Color>(colors, lo, hi, out);     // out[i] = clamp(colors[i], lo, hi)
+//   dmopex::aabb<Vector3D> box = dmopex::bounds<Vector3D>(points);   // box.lo / box.hi
+//
+// Works on reflected structs (nested members and arrays included), arrays and plain
+// arithmetic values, with the semantics of std::min / std::max / std::clamp per leaf.
+// When all leaves share one arithmetic type and the struct has no padding, the batch
+// versions run over the flat array of leaves in fixed-size blocks the compiler turns into
+// vector min / max instructions; bounds keeps one block of running minima and maxima and
+// folds it into the leaves at the end. Other types go element by element.
+// With NaN leaves the result of the batch reductions depends on the order of evaluation.
+// min and max are declared and called as (min) / (max), so the macros of <windows.h> do
+// not expand them.
+
+namespace dmopex {
+    template<typename T>
+    struct aabb {
+        T lo;
+        T hi;
+    };
+
+    namespace minmax_detail {
+        template<typename M>
+        constexpr M min_leaf(const M& a, const M& b) { return b < a ? b : a; }
+
+        template<typename M>
+        constexpr M max_leaf(const M& a, const M& b) { return a < b ? b : a; }
+
+        struct min_op {
+            template<typename M>
+            constexpr M operator()(const M& a, const M& b) const { return minmax_detail::min_leaf(a, b); }
+        };
+
+        struct max_op {
+            template<typename M>
+            constexpr M operator()(const M& a, const M& b) const { return minmax_detail::max_leaf(a, b); }
+        };
+
+        // std::clamp as max then min, the same result for every value including NaN
+        struct clamp_op {
+            template<typename M>
+            constexpr M operator()(const M& v, const M& lo, const M& hi) const {
+                return minmax_detail::min_leaf(minmax_detail::max_leaf(v, lo), hi);
+            }
+        };
+
+        struct abs_op {
+            template<typename M>
+            M operator()(const M& v) const {
+                if constexpr (std::is_floating_point_v<M>) {
+                    return std::abs(v);
+                } else if constexpr (std::is_signed_v<M>) {
+                    return v < 0 ? static_cast<M>(-v) : v;
+                } else {
+                    return v;
+                }
+            }
+        };
+
+        // Leaf type and leaves per element of T seen as a flat array, 0 leaves when it is not one
+        template<typename T, typename = void>
+        struct uniform {
+            using leaf_type = T;
+            static constexpr std::size_t leaves = 0;
+        };
+
+        template<typename T>
+        struct uniform<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+            using leaf_type = T;
+            static constexpr std::size_t leaves = 1;
+        };
+
+        template<typename T>
+        struct uniform<T, std::enable_if_t<is_reflected_v<T>>> {
+            using leaf_type = typename batch_detail::flat_layout<T>::leaf_type;
+            static constexpr std::size_t leaves = batch_detail::flat_layout<T>::value ? sizeof(T) / sizeof(leaf_type) : 0;
+        };
+
+        // Leaves in a block: a whole number of elements and enough leaves for several vectors
+        template<typename T>
+        inline constexpr std::size_t block_v = uniform<T>::leaves * (64 / sizeof(typename uniform<T>::leaf_type) < 4 ? 4 : 64 / sizeof(typename uniform<T>::leaf_type));
+
+        // value repeated to fill one block of leaves
+        template<typename T, typename L = typename uniform<T>::leaf_type>
+        void repeat(const T& value, L (&pattern)[block_v<T>]) {
+            const L* leaf = reinterpret_cast<const L*>(&value);
+            for (std::size_t e = 0; e < block_v<T>; ++e) {
+                pattern[e] = leaf[e % uniform<T>::leaves];
+            }
+        }
+
+        // kernel(i, e) for every leaf i + e of count leaves, in blocks of block_v<T> leaves
+        // so that e is also the leaf's position in a repeated pattern
+        template<typename T, typename Kernel>
+        void for_each_leaf(std::size_t count, Kernel kernel) {
+            constexpr std::size_t block = block_v<T>;
+            std::size_t i = 0;
+            for (; i + block <= count; i += block) {
+                DMOPEX_IVDEP
+                for (std::size_t e = 0; e < block; ++e) {
+                    kernel(i, e);
+                }
+            }
+            for (std::size_t e = 0; i + e < count; ++e) {
+                kernel(i, e);
+            }
+        }
+
+        template<typename T, typename Op>
+        void batch_pair(const T* a, const T* b, T* out, std::size_t n, Op op) {
+            if constexpr (uniform<T>::leaves != 0) {
+                using L = typename uniform<T>::leaf_type;
+                const L* x = reinterpret_cast<const L*>(a);
+                const L* y = reinterpret_cast<const L*>(b);
+                L* z = reinterpret_cast<L*>(out);
+                minmax_detail::for_each_leaf<T>(n * uniform<T>::leaves, [x, y, z, op](std::size_t i, std::size_t e) {
+                    z[i + e] = op(x[i + e], y[i + e]);
+                });
+            } else {
+                for (std::size_t i = 0; i < n; ++i) {
+                    T result = a[i];
+                    fields_detail::zip(op, result, a[i], b[i]);
+                    out[i] = result;
+                }
+            }
+        }
+
+        // Fold of op over all elements, leaf by leaf
+        template<typename T, typename Op>
+        T fold(const T* a, std::size_t n, Op op) {
+            assert(n != 0);
+            T result = a[0];
+            if constexpr (uniform<T>::leaves != 0) {
+                using L = typename uniform<T>::leaf_type;
+                constexpr std::size_t block = block_v<T>;
+                const L* x = reinterpret_cast<const L*>(a);
+                const std::size_t count = n * uniform<T>::leaves;
+                L acc[block];
+                minmax_detail::repeat(a[0], acc);
+                std::size_t i = 0;
+                for (; i + block <= count; i += block) {
+                    DMOPEX_IVDEP
+                    for (std::size_t e = 0; e < block; ++e) {
+                        acc[e] = op(acc[e], x[i + e]);
+                    }
+                }
+                for (std::size_t e = 0; i + e < count; ++e) {
+                    acc[e] = op(acc[e], x[i + e]);
+                }
+                L* leaf = reinterpret_cast<L*>(&result);
+                for (std::size_t e = 0; e < block; ++e) {
+                    leaf[e % uniform<T>::leaves] = op(leaf[e % uniform<T>::leaves], acc[e]);
+                }
+            } else {
+                for (std::size_t i = 1; i < n; ++i) {
+                    fields_detail::zip(op, result, result, a[i]);
+                }
+            }
+            return result;
+        }
+    } // namespace minmax_detail
+
+    template<typename T>
+    constexpr T (min)(const T& a, const T& b) {
+        T result = a;
+        minmax_detail::min_op op;
+        fields_detail::zip(op, result, a, b);
+        return result;
+    }
+
+    template<typename T>
+    constexpr T (max)(const T& a, const T& b) {
+        T result = a;
+        minmax_detail::max_op op;
+        fields_detail::zip(op, result, a, b);
+        return result;
+    }
+
+    // Every leaf of v limited to the range given by the same leaf of lo and hi
+    template<typename T>
+    constexpr T clamp(const T& v, const T& lo, const T& hi) {
+        T result = v;
+        minmax_detail::clamp_op op;
+        fields_detail::zip(op, result, v, lo, hi);
+        return result;
+    }
+
+    template<typename T>
+    T abs(const T& v) {
+        T result = v;
+        minmax_detail::abs_op op;
+        fields_detail::zip(op, result, v);
+        return result;
+    }
+
+    // Batch versions, out must hold at least a.size() elements and may be the same array as an input
+    template<typename T>
+    void batch_min(span<const T> a, span<const T> b, span<T> out) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        minmax_detail::batch_pair(a.data(), b.data(), out.data(), a.size(), minmax_detail::min_op{});
+    }
+
+    template<typename T>
+    void batch_max(span<const T> a, span<const T> b, span<T> out) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        minmax_detail::batch_pair(a.data(), b.data(), out.data(), a.size(), minmax_detail::max_op{});
+    }
+
+    template<typename T>
+    void batch_clamp(span<const T> a, const T& lo, const T& hi, span<T> out) {
+        assert(out.size() >= a.size());
+        minmax_detail::clamp_op op;
+        if constexpr (minmax_detail::uniform<T>::leaves != 0) {
+            using L = typename minmax_detail::uniform<T>::leaf_type;
+            L lo_leaves[minmax_detail::block_v<T>], hi_leaves[minmax_detail::block_v<T>];
+            minmax_detail::repeat(lo, lo_leaves);
+            minmax_detail::repeat(hi, hi_leaves);
+            const L* x = reinterpret_cast<const L*>(a.data());
+            L* z = reinterpret_cast<L*>(out.data());
+            minmax_detail::for_each_leaf<T>(a.size() * minmax_detail::uniform<T>::leaves, [&, x, z](std::size_t i, std::size_t e) {
+                z[i + e] = op(x[i + e], lo_leaves[e], hi_leaves[e]);
+            });
+        } else {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                out[i] = dmopex::clamp(a[i], lo, hi);
+            }
+        }
+    }
+
+    template<typename T>
+    void batch_abs(span<const T> a, span<T> out) {
+        assert(out.size() >= a.size());
+        minmax_detail::abs_op op;
+        if constexpr (minmax_detail::uniform<T>::leaves != 0) {
+            using L = typename minmax_detail::uniform<T>::leaf_type;
+            const L* x = reinterpret_cast<const L*>(a.data());
+            L* z = reinterpret_cast<L*>(out.data());
+            minmax_detail::for_each_leaf<T>(a.size() * minmax_detail::uniform<T>::leaves, [x, z, op](std::size_t i, std::size_t e) {
+                z[i + e] = op(x[i + e]);
+            });
+        } else {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                out[i] = dmopex::abs(a[i]);
+            }
+        }
+    }
+
+    // Array-wide reductions over a non-empty array: the member-wise minimum, maximum or both
+    template<typename T>
+    T min_of(span<const T> a) {
+        return minmax_detail::fold(a.data(), a.size(), minmax_detail::min_op{});
+    }
+
+    template<typename T>
+    T max_of(span<const T> a) {
+        return minmax_detail::fold(a.data(), a.size(), minmax_detail::max_op{});
+    }
+
+    // Axis-aligned bounding box of the elements: both folds in one pass over the array
+    template<typename T>
+    aabb<T> bounds(span<const T> a) {
+        assert(!a.empty());
+        aabb<T> box{ a[0], a[0] };
+        minmax_detail::min_op lower;
+        minmax_detail::max_op upper;
+        if constexpr (minmax_detail::uniform<T>::leaves != 0) {
+            using L = typename minmax_detail::uniform<T>::leaf_type;
+            constexpr std::size_t block = minmax_detail::block_v<T>;
+            const L* x = reinterpret_cast<const L*>(a.data());
+            const std::size_t count = a.size() * minmax_detail::uniform<T>::leaves;
+            L lo[block], hi[block];
+            minmax_detail::repeat(a[0], lo);
+            minmax_detail::repeat(a[0], hi);
+            std::size_t i = 0;
+            for (; i + block <= count; i += block) {
+                DMOPEX_IVDEP
+                for (std::size_t e = 0; e < block; ++e) {
+                    lo[e] = lower(lo[e], x[i + e]);
+                    hi[e] = upper(hi[e], x[i + e]);
+                }
+            }
+            for (std::size_t e = 0; i + e < count; ++e) {
+                lo[e] = lower(lo[e], x[i + e]);
+                hi[e] = upper(hi[e], x[i + e]);
+            }
+            L* box_lo = reinterpret_cast<L*>(&box.lo);
+            L* box_hi = reinterpret_cast<L*>(&box.hi);
+            for (std::size_t e = 0; e < block; ++e) {
+                box_lo[e % minmax_detail::uniform<T>::leaves] = lower(box_lo[e % minmax_detail::uniform<T>::leaves], lo[e]);
+                box_hi[e % minmax_detail::uniform<T>::leaves] = upper(box_hi[e % minmax_detail::uniform<T>::leaves], hi[e]);
+            }
+        } else {
+            for (std::size_t i = 1; i < a.size(); ++i) {
+                fields_detail::zip(lower, box.lo, box.lo, a[i]);
+                fields_detail::zip(upper, box.hi, box.hi, a[i]);
+            }
+        }
+        return box;
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_MINMAX_H_INCLUDE__
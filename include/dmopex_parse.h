@@ -0,0 +1,360 @@
+﻿#ifndef __DMOPEX_PARSE_H_INCLUDE__
+#define __DMOPEX_PARSE_H_INCLUDE__
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <charconv>
+#include <exception>
+#include <algorithm>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "dmopex_fields.h"
+
+// Reader for the text written by operator<< and the dmformat formatter:
+//
+//   "(1.5, 2.5)"             plain form
+//   "(x: 1.5, y: 2.5)"       named form, names must match the declaration order
+//   "((1, 2, 3), 7)"         nested reflected members
+//   "([1, 2, 3], 7)"         array members (C arrays and std::array), exact extent required
+//
+// Numbers go through std::from_chars: no locale, no allocation. char members are single
+// characters, taken verbatim from where operator<< writes them.
+
+namespace dmopex {
+    struct parse_status {
+        std::errc ec = std::errc();  // invalid_argument for syntax errors, result_out_of_range for overflow
+        std::size_t position = 0;    // byte offset of the error, or of the end of the parsed text
+        std::size_t line = 0;        // zero-based line of the error (parse_lines only)
+
+        constexpr explicit operator bool() const noexcept { return ec == std::errc(); }
+    };
+
+    template<typename T>
+    struct parse_result {
+        T value{};
+        parse_status status;
+
+        constexpr explicit operator bool() const noexcept { return static_cast<bool>(status); }
+    };
+
+    namespace parse_detail {
+        struct cursor {
+            const char* begin;
+            const char* it;
+            const char* end;
+            std::errc ec;
+
+            bool fail(std::errc error, const char* where) noexcept {
+                ec = error;
+                it = where;
+                return false;
+            }
+        };
+
+        inline bool is_space(char c) noexcept {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        inline bool is_name_char(char c) noexcept {
+            return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        }
+
+        inline void skip_space(cursor& cur) noexcept {
+            while (cur.it != cur.end && is_space(*cur.it)) {
+                ++cur.it;
+            }
+        }
+
+        inline bool expect(cursor& cur, char c) noexcept {
+            skip_space(cur);
+            if (cur.it == cur.end || *cur.it != c) {
+                return cur.fail(std::errc::invalid_argument, cur.it);
+            }
+            ++cur.it;
+            return true;
+        }
+
+        template<typename T>
+        bool read_value(cursor& cur, T& value);
+
+        template<typename T, std::size_t I>
+        bool read_member(cursor& cur, T& obj) {
+            using meta = fields<T>;
+            if constexpr (I != 0) {
+                if (!expect(cur, ',')) {
+                    return false;
+                }
+            }
+
+            // Optional "name:" prefix as written by the named formatter. Without one the value is
+            // read from just after the separator: value readers skip whitespace, except for char
+            const char* value_start = cur.it;
+            skip_space(cur);
+            const char* name_end = cur.it;
+            while (name_end != cur.end && is_name_char(*name_end)) {
+                ++name_end;
+            }
+            const char* colon = name_end;
+            while (colon != cur.end && is_space(*colon)) {
+                ++colon;
+            }
+            if (name_end != cur.it && colon != cur.end && *colon == ':') {
+                std::string_view name(cur.it, static_cast<std::size_t>(name_end - cur.it));
+                if (name != meta::names[I]) {
+                    return cur.fail(std::errc::invalid_argument, cur.it);
+                }
+                cur.it = colon + 1;
+            }
+            else {
+                cur.it = value_start;
+            }
+            return parse_detail::read_value(cur, obj.*std::get<I>(meta::pointers));
+        }
+
+        template<typename T, std::size_t... I>
+        bool read_struct(cursor& cur, T& obj, std::index_sequence<I...>) {
+            return expect(cur, '(') && (parse_detail::read_member<T, I>(cur, obj) && ...) && expect(cur, ')');
+        }
+
+        template<typename T>
+        bool read_value(cursor& cur, T& value) {
+            if constexpr (is_reflected_v<T>) {
+                return parse_detail::read_struct(cur, value, std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (fields_detail::is_array_v<T>) {
+                if (!expect(cur, '[')) {
+                    return false;
+                }
+                for (std::size_t k = 0; k < fields_detail::array_traits<T>::size; ++k) {
+                    if ((k != 0 && !expect(cur, ',')) || !parse_detail::read_value(cur, value[k])) {
+                        return false;
+                    }
+                }
+                return expect(cur, ']');
+            } else if constexpr (std::is_same_v<T, bool>) {
+                skip_space(cur);
+                std::string_view rest(cur.it, static_cast<std::size_t>(cur.end - cur.it));
+                for (std::string_view token : { std::string_view("1"), std::string_view("true"), std::string_view("0"), std::string_view("false") }) {
+                    if (rest.substr(0, token.size()) == token) {
+                        value = token[0] == '1' || token[0] == 't';
+                        cur.it += token.size();
+                        return true;
+                    }
+                }
+                return cur.fail(std::errc::invalid_argument, cur.it);
+            } else if constexpr (std::is_same_v<T, char>) {
+                // The character itself, where operator<< puts it: right after '(' or '[', or after
+                // the one space following ',' or "name:". Nothing else is skipped, so ' ' reads back
+                if (cur.it != cur.begin && (cur.it[-1] == ',' || cur.it[-1] == ':') && cur.it != cur.end && *cur.it == ' ') {
+                    ++cur.it;
+                }
+                if (cur.it == cur.end) {
+                    return cur.fail(std::errc::invalid_argument, cur.it);
+                }
+                value = *cur.it++;
+                return true;
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                skip_space(cur);
+                auto result = std::from_chars(cur.it, cur.end, value);
+                if (result.ec != std::errc()) {
+                    return cur.fail(result.ec, cur.it);
+                }
+                cur.it = result.ptr;
+                return true;
+            } else {
+                static_assert(is_reflected_v<T> || std::is_arithmetic_v<T>, "dmopex::parse supports arithmetic, array and reflected members");
+                return false;
+            }
+        }
+
+        template<typename T>
+        parse_status parse_into(std::string_view text, T& out) noexcept {
+            cursor cur{ text.data(), text.data(), text.data() + text.size(), std::errc() };
+            if (parse_detail::read_value(cur, out)) {
+                skip_space(cur);
+                if (cur.it != cur.end) {
+                    cur.fail(std::errc::invalid_argument, cur.it);
+                }
+            }
+            return parse_status{ cur.ec, static_cast<std::size_t>(cur.it - cur.begin), 0 };
+        }
+
+        // Calls f(line) for every non-blank line of text, line excluding its terminator
+        template<typename F>
+        void for_each_line(std::string_view text, F&& f) {
+            while (!text.empty()) {
+                std::size_t eol = text.find('\n');
+                std::string_view line = text.substr(0, eol);
+                if (std::any_of(line.begin(), line.end(), [](char c) { return !is_space(c); })) {
+                    if (!f(line)) {
+                        return;
+                    }
+                }
+                if (eol == std::string_view::npos) {
+                    return;
+                }
+                text.remove_prefix(eol + 1);
+            }
+        }
+    } // namespace parse_detail
+
+    // Parses one struct from text into out. Whitespace around tokens is ignored;
+    // anything after the closing parenthesis other than whitespace is an error.
+    template<typename T>
+    parse_status parse(std::string_view text, T& out) noexcept {
+        static_assert(is_reflected_v<T>, "dmopex::parse requires a reflected struct");
+        return parse_detail::parse_into(text, out);
+    }
+
+    template<typename T>
+    parse_result<T> parse(std::string_view text) {
+        parse_result<T> result;
+        result.status = dmopex::parse(text, result.value);
+        return result;
+    }
+
+    struct parse_lines_options {
+        unsigned threads = 0;                   // 0 = std::thread::hardware_concurrency()
+        std::size_t min_chunk_bytes = 1 << 20;  // inputs are not split below this size per thread
+    };
+
+    // Parses one struct per non-blank line of text and appends them to out in line order.
+    // Large inputs are cut at line boundaries into one chunk per thread: a first parallel pass
+    // counts the lines of every chunk, then each chunk is parsed straight into its slice of out.
+    // On failure, out keeps only the structs preceding the first bad line. If a thread cannot be
+    // started, the others stop, out is restored to its former size and the exception is rethrown.
+    template<typename T>
+    parse_status parse_lines(std::string_view text, std::vector<T>& out, const parse_lines_options& options = {}) {
+        static_assert(is_reflected_v<T>, "dmopex::parse_lines requires a reflected struct");
+
+        unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        std::size_t max_chunks = text.size() / (std::max)(options.min_chunk_bytes, std::size_t(1)) + 1;
+        threads = static_cast<unsigned>((std::min<std::size_t>)((std::max)(threads, 1u), max_chunks));
+
+        // Chunk boundaries, each one just past a newline
+        std::vector<std::size_t> bounds{ 0 };
+        for (unsigned i = 1; i < threads; ++i) {
+            std::size_t pos = (std::max)(text.size() * i / threads, bounds.back());
+            pos = text.find('\n', pos);
+            if (pos == std::string_view::npos) {
+                break;
+            }
+            bounds.push_back(pos + 1);
+        }
+        bounds.push_back(text.size());
+        const std::size_t chunk_count = bounds.size() - 1;
+
+        auto chunk_text = [&](std::size_t chunk) {
+            return text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+        };
+
+        std::mutex error_mutex;
+        std::exception_ptr error;           // first exception of a task or a thread start
+        std::atomic<bool> failed{ false };  // tasks stop at their next line once set
+
+        auto fail = [&](std::exception_ptr e) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = e;
+            }
+            failed = true;
+        };
+
+        // Runs task(chunk) for every chunk, chunk 0 on the calling thread; an exception is
+        // rethrown here once every started thread has joined
+        auto run = [&](auto&& task) {
+            auto guarded = [&](std::size_t chunk) {
+                try {
+                    task(chunk);
+                }
+                catch (...) {
+                    fail(std::current_exception());
+                }
+            };
+            std::vector<std::thread> workers;
+            try {
+                workers.reserve(chunk_count);
+                for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+                    workers.emplace_back(guarded, chunk);
+                }
+            }
+            catch (...) {
+                fail(std::current_exception());
+            }
+            if (!failed) {
+                guarded(std::size_t(0));
+            }
+            for (auto& t : workers) {
+                t.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        };
+
+        auto count_lines = [&](std::size_t chunk) {
+            std::size_t count = 0;
+            parse_detail::for_each_line(chunk_text(chunk), [&](std::string_view) {
+                ++count;
+                return !failed.load(std::memory_order_relaxed);
+            });
+            return count;
+        };
+
+        // first_item[c] = index of the first struct of chunk c
+        std::vector<std::size_t> first_item(chunk_count + 1, 0);
+        if (chunk_count > 1) {
+            run([&](std::size_t chunk) { first_item[chunk + 1] = count_lines(chunk); });
+            for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                first_item[chunk + 1] += first_item[chunk];
+            }
+        }
+        else {
+            first_item[1] = count_lines(0);
+        }
+
+        const std::size_t base = out.size();
+        out.resize(base + first_item[chunk_count]);
+
+        std::vector<parse_status> errors(chunk_count);
+        std::vector<std::size_t> error_item(chunk_count, 0);
+        try {
+            run([&](std::size_t chunk) {
+                std::size_t item = first_item[chunk];
+                parse_detail::for_each_line(chunk_text(chunk), [&](std::string_view line) {
+                    if (failed.load(std::memory_order_relaxed)) {
+                        return false;
+                    }
+                    parse_status status = parse_detail::parse_into(line, out[base + item]);
+                    if (!status) {
+                        status.position += static_cast<std::size_t>(line.data() - text.data());
+                        errors[chunk] = status;
+                        error_item[chunk] = item;
+                        return false;
+                    }
+                    ++item;
+                    return true;
+                });
+            });
+        }
+        catch (...) {
+            out.resize(base);
+            throw;
+        }
+
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            parse_status status = errors[chunk];
+            if (!status) {
+                status.line = static_cast<std::size_t>(std::count(text.begin(), text.begin() + status.position, '\n'));
+                out.resize(base + error_item[chunk]);
+                return status;
+            }
+        }
+        return parse_status{ std::errc(), text.size(), 0 };
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_PARSE_H_INCLUDE__
@@ -0,0 +1,202 @@
+﻿#ifndef __DMOPEX_PIPELINE_H_INCLUDE__
+#define __DMOPEX_PIPELINE_H_INCLUDE__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_batch.h"
+#include "dmopex_arena.h"
+
+// Chains of element-wise batch arithmetic fused into a single pass:
+//
+//   auto e = (dmopex::lazy(a) + dmopex::lazy(b)) * dmopex::lazy(s) - dmopex::lazy(f);
+//   dmopex::evaluate(e, out);                          // out[i] = (a[i] + b[i]) * s[i] - f[i]
+//   auto g = dmopex::lazy(a) * Vector3D{ 2, 2, 2 };    // a single value applies to every element
+//   span<Vector3D> h = dmopex::evaluate(scratch, g);   // output allocated from a dmopex::arena
+//
+// Building the expression computes nothing. evaluate walks the arrays in blocks of a few
+// KiB: every operation of the chain runs over one block with the batch kernels of
+// dmopex_batch.h (vectorized the same way as batch_add and friends), intermediate results
+// stay in block-sized buffers on the stack, and the block is written to out once. Each
+// input is read once from memory and the output written once, instead of one pass per
+// operation. Arithmetic follows the operators of the element type (policies included), as
+// batch_add does. out may be one of the inputs.
+
+namespace dmopex {
+    namespace pipeline_detail {
+        // Elements per block: 4 KiB of T, at least 16 elements
+        template<typename T>
+        inline constexpr std::size_t block_v = 4096 / sizeof(T) < 16 ? 16 : 4096 / sizeof(T);
+
+        inline constexpr std::size_t any_size = static_cast<std::size_t>(-1);
+
+        // Nodes produce the values of elements [i, i + n), n <= block_v<T>, either as a pointer
+        // into their own storage or written to scratch
+
+        // An input array
+        template<typename T>
+        struct array_node {
+            using value_type = T;
+
+            const T* data;
+            std::size_t count;
+
+            std::size_t size() const noexcept { return count; }
+
+            bool overlaps(const void* begin, const void* end) const noexcept {
+                return std::less<const void*>{}(data, end) && std::less<const void*>{}(begin, data + count);
+            }
+
+            const T* eval(std::size_t i, std::size_t, T*) const noexcept { return data + i; }
+        };
+
+        // One value for every element
+        template<typename T>
+        struct value_node {
+            using value_type = T;
+
+            T value;
+
+            std::size_t size() const noexcept { return any_size; }
+
+            bool overlaps(const void*, const void*) const noexcept { return false; }
+
+            const T* eval(std::size_t, std::size_t n, T* scratch) const {
+                std::fill_n(scratch, n, value);
+                return scratch;
+            }
+        };
+
+        template<typename Op, typename L, typename R>
+        struct binary_node {
+            using value_type = typename L::value_type;
+
+            L left;
+            R right;
+
+            std::size_t size() const noexcept {
+                const std::size_t l = left.size();
+                const std::size_t r = right.size();
+                assert(l == any_size || r == any_size || l == r);
+                return l == any_size ? r : l;
+            }
+
+            bool overlaps(const void* begin, const void* end) const noexcept {
+                return left.overlaps(begin, end) || right.overlaps(begin, end);
+            }
+
+            // The left operand is computed in scratch and the result written over it; the
+            // right operand gets its own block on the stack
+            const value_type* eval(std::size_t i, std::size_t n, value_type* scratch) const {
+                value_type buffer[block_v<value_type>];
+                const value_type* a = left.eval(i, n, scratch);
+                const value_type* b = right.eval(i, n, buffer);
+                batch_kernel<value_type, Op>::apply(a, b, scratch, n);
+                return scratch;
+            }
+        };
+    } // namespace pipeline_detail
+
+    // Deferred element-wise computation over arrays of T, see dmopex::lazy
+    template<typename Node>
+    class lazy_expr {
+    public:
+        using value_type = typename Node::value_type;
+
+        explicit lazy_expr(const Node& node) : node_(node) {}
+
+        const Node& node() const noexcept { return node_; }
+
+        // Elements in the arrays of the expression
+        std::size_t size() const noexcept { return node_.size(); }
+
+        // out[i] = value of element i for i < size(), in one pass over the inputs
+        void evaluate(span<value_type> out) const {
+            using T = value_type;
+            constexpr std::size_t block = pipeline_detail::block_v<T>;
+            const std::size_t n = size();
+            assert(n != pipeline_detail::any_size && out.size() >= n);
+            // The block of out is used as scratch unless an input lives there
+            const bool in_place = !node_.overlaps(out.data(), out.data() + n);
+            T buffer[block];
+            for (std::size_t i = 0; i < n; i += block) {
+                const std::size_t count = n - i < block ? n - i : block;
+                T* scratch = in_place ? out.data() + i : buffer;
+                const T* result = node_.eval(i, count, scratch);
+                if (result != out.data() + i) {
+                    std::copy_n(result, count, out.data() + i);
+                }
+            }
+        }
+
+    private:
+        Node node_;
+    };
+
+    // Starts an expression from an array (span, std::vector, C array...); the array must
+    // outlive the expression
+    template<typename Range, typename = std::enable_if_t<span_detail::borrowed_v<Range>>>
+    auto lazy(Range&& range) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(range))>>;
+        using node = pipeline_detail::array_node<T>;
+        return lazy_expr<node>(node{ std::data(range), static_cast<std::size_t>(std::size(range)) });
+    }
+
+    // The elements of a temporary container are gone before the expression is evaluated
+    template<typename Range>
+    std::enable_if_t<!span_detail::borrowed_v<Range>> lazy(Range&&) = delete;
+
+    template<typename Node>
+    void evaluate(const lazy_expr<Node>& expr, span<typename Node::value_type> out) {
+        expr.evaluate(out);
+    }
+
+    // Evaluated into an array allocated from scratch
+    template<typename Node>
+    span<typename Node::value_type> evaluate(arena& scratch, const lazy_expr<Node>& expr) {
+        span<typename Node::value_type> out = scratch.allocate<typename Node::value_type>(expr.size());
+        expr.evaluate(out);
+        return out;
+    }
+
+    namespace pipeline_detail {
+        template<typename Op, typename L, typename R>
+        lazy_expr<binary_node<Op, L, R>> combine(const L& left, const R& right) {
+            static_assert(std::is_same_v<typename L::value_type, typename R::value_type>, "dmopex::lazy operands must have one element type");
+            return lazy_expr<binary_node<Op, L, R>>(binary_node<Op, L, R>{ left, right });
+        }
+
+        template<typename T>
+        value_node<T> value(const T& v) { return value_node<T>{ v }; }
+    } // namespace pipeline_detail
+
+#define DMOPEX_LAZY_OPERATOR(op, Op) \
+    template<typename L, typename R> \
+    auto operator op(const lazy_expr<L>& a, const lazy_expr<R>& b) { \
+        return pipeline_detail::combine<Op>(a.node(), b.node()); \
+    } \
+    \
+    template<typename L> \
+    auto operator op(const lazy_expr<L>& a, const typename L::value_type& b) { \
+        return pipeline_detail::combine<Op>(a.node(), pipeline_detail::value(b)); \
+    } \
+    \
+    template<typename R> \
+    auto operator op(const typename R::value_type& a, const lazy_expr<R>& b) { \
+        return pipeline_detail::combine<Op>(pipeline_detail::value(a), b.node()); \
+    }
+
+    DMOPEX_LAZY_OPERATOR(+, std::plus<>)
+    DMOPEX_LAZY_OPERATOR(-, std::minus<>)
+    DMOPEX_LAZY_OPERATOR(*, std::multiplies<>)
+    DMOPEX_LAZY_OPERATOR(/, std::divides<>)
+
+#undef DMOPEX_LAZY_OPERATOR
+} // namespace dmopex
+
+#endif // __DMOPEX_PIPELINE_H_INCLUDE__
@@ -0,0 +1,434 @@
+﻿#ifndef __DMOPEX_POLICY_H_INCLUDE__
+#define __DMOPEX_POLICY_H_INCLUDE__
+
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "dmopex_fields.h"
+
+// Arithmetic policies applied member by member by the generated operators.
+// Reflected members are recursed into with their own policy, array members are taken
+// element by element; any other non-arithmetic member uses its own operators.
+//
+//   wrap_policy      integers wrap around modulo 2^N (the default)
+//   saturate_policy  integers clamp to the range of the member type
+//   checked_policy   integer overflow throws std::overflow_error,
+//                    integer division by zero throws std::domain_error
+//
+// A policy declares nothrow<T> for the arithmetic types it never throws for; the generated
+// operators are noexcept when every leaf is. A policy without it counts as throwing.
+
+namespace dmopex {
+    template<typename T>
+    struct policy_of;
+
+    namespace policy_detail {
+        template<typename T>
+        inline constexpr bool is_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+        // Unsigned type wide enough for T after integral promotion
+        template<typename T>
+        using wrap_type = std::make_unsigned_t<std::common_type_t<T, unsigned int>>;
+
+        // Exact result of a op b for integers, or false when it does not fit in T
+        template<typename T>
+        constexpr bool add_fits(T a, T b, T& out) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                if ((b > 0 && a > (std::numeric_limits<T>::max)() - b) || (b < 0 && a < (std::numeric_limits<T>::min)() - b)) {
+                    return false;
+                }
+            } else if (a > (std::numeric_limits<T>::max)() - b) {
+                return false;
+            }
+            out = static_cast<T>(a + b);
+            return true;
+        }
+
+        template<typename T>
+        constexpr bool sub_fits(T a, T b, T& out) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                if ((b < 0 && a > (std::numeric_limits<T>::max)() + b) || (b > 0 && a < (std::numeric_limits<T>::min)() + b)) {
+                    return false;
+                }
+            } else if (a < b) {
+                return false;
+            }
+            out = static_cast<T>(a - b);
+            return true;
+        }
+
+        template<typename T>
+        constexpr bool mul_fits(T a, T b, T& out) noexcept {
+            if (a == 0 || b == 0) {
+                out = 0;
+                return true;
+            }
+            if constexpr (std::is_signed_v<T>) {
+                if ((a == -1 && b == (std::numeric_limits<T>::min)()) || (b == -1 && a == (std::numeric_limits<T>::min)())) {
+                    return false;
+                }
+                T limit = (a > 0) == (b > 0) ? (std::numeric_limits<T>::max)() : (std::numeric_limits<T>::min)();
+                if ((a > 0) == (b > 0) ? (a > 0 ? a > limit / b : a < limit / b) : (a > 0 ? b < limit / a : a < limit / b)) {
+                    return false;
+                }
+            } else if (a > (std::numeric_limits<T>::max)() / b) {
+                return false;
+            }
+            out = static_cast<T>(a * b);
+            return true;
+        }
+
+        template<typename T>
+        constexpr bool div_fits(T a, T b, T& out) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                if (a == (std::numeric_limits<T>::min)() && b == -1) {
+                    return false;
+                }
+            }
+            out = static_cast<T>(a / b);
+            return true;
+        }
+
+        // Value a saturated overflow of a op b lands on
+        template<typename T>
+        constexpr T saturate_limit(bool negative) noexcept {
+            return negative ? (std::numeric_limits<T>::min)() : (std::numeric_limits<T>::max)();
+        }
+
+        // Integers narrower than int saturate by computing the exact result in a wider type
+        // and clamping it, cheaper than testing for overflow first: sums and differences fit
+        // in int, products need twice the bits of T
+        template<typename T>
+        inline constexpr bool is_narrow_v = is_integer_v<T> && sizeof(T) < sizeof(int);
+
+        template<typename T>
+        using product_type = std::conditional_t<(sizeof(T) * 2 < sizeof(int)), int, long long>;
+
+        // Clamped in W one bound after the other and narrowed once: written as a single
+        // conditional, GCC computes the result twice
+        template<typename T, typename W>
+        constexpr T clamp_to(W value) noexcept {
+            constexpr W high = static_cast<W>((std::numeric_limits<T>::max)());
+            constexpr W low = static_cast<W>((std::numeric_limits<T>::min)());
+            value = value < low ? low : value;
+            value = value > high ? high : value;
+            return static_cast<T>(value);
+        }
+
+        // Operation tags: apply<Policy> goes through a policy, plain through the type's own operator
+        struct add_op {
+            template<typename P, typename T> static constexpr T apply(const T& a, const T& b) { return P::add(a, b); }
+            template<typename T> static constexpr T plain(const T& a, const T& b) { return a + b; }
+            template<typename T> using plain_noexcept = std::bool_constant<noexcept(std::declval<const T&>() + std::declval<const T&>())>;
+        };
+
+        struct sub_op {
+            template<typename P, typename T> static constexpr T apply(const T& a, const T& b) { return P::sub(a, b); }
+            template<typename T> static constexpr T plain(const T& a, const T& b) { return a - b; }
+            template<typename T> using plain_noexcept = std::bool_constant<noexcept(std::declval<const T&>() - std::declval<const T&>())>;
+        };
+
+        struct mul_op {
+            template<typename P, typename T> static constexpr T apply(const T& a, const T& b) { return P::mul(a, b); }
+            template<typename T> static constexpr T plain(const T& a, const T& b) { return a * b; }
+            template<typename T> using plain_noexcept = std::bool_constant<noexcept(std::declval<const T&>() * std::declval<const T&>())>;
+        };
+
+        struct div_op {
+            template<typename P, typename T> static constexpr T apply(const T& a, const T& b) { return P::div(a, b); }
+            template<typename T> static constexpr T plain(const T& a, const T& b) { return a / b; }
+            template<typename T> using plain_noexcept = std::bool_constant<noexcept(std::declval<const T&>() / std::declval<const T&>())>;
+        };
+
+        // dst = a op b under policy P; arrays (C arrays and std::array) element by element.
+        // dst may be the same object as a.
+        template<typename Op, typename P, typename M>
+        constexpr void assign(M& dst, const M& a, const M& b) {
+            if constexpr (fields_detail::is_array_v<M>) {
+                for (std::size_t k = 0; k < fields_detail::array_traits<M>::size; ++k) {
+                    policy_detail::assign<Op, P>(dst[k], a[k], b[k]);
+                }
+            } else {
+                dst = Op::template apply<P>(a, b);
+            }
+        }
+
+        template<typename Op, typename T, std::size_t... I>
+        constexpr void compound_members(T& result, const T& a, const T& b, std::index_sequence<I...>) {
+            using P = typename policy_of<T>::type;
+            (policy_detail::assign<Op, P>(dmopex::get<I>(result), dmopex::get<I>(a), dmopex::get<I>(b)), ...);
+        }
+
+        // Non-arithmetic member: reflected structs recurse member by member with their own policy,
+        // so nested structs need no operators of their own; std::array goes element by element
+        template<typename Op, typename T>
+        constexpr T compound(const T& a, const T& b) {
+            if constexpr (is_reflected_v<T>) {
+                T result = a;
+                policy_detail::compound_members<Op>(result, a, b, std::make_index_sequence<fields<T>::size>{});
+                return result;
+            } else if constexpr (fields_detail::is_array_v<T>) {
+                T result = a;
+                policy_detail::assign<Op, typename policy_of<T>::type>(result, a, b);
+                return result;
+            } else {
+                return Op::plain(a, b);
+            }
+        }
+    } // namespace policy_detail
+
+    struct wrap_policy {
+        template<typename T>
+        static constexpr bool nothrow = true;
+
+        template<typename T>
+        static constexpr T add(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                using U = policy_detail::wrap_type<T>;
+                return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<T>(a + b);
+            } else {
+                return policy_detail::compound<policy_detail::add_op>(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T sub(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                using U = policy_detail::wrap_type<T>;
+                return static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<T>(a - b);
+            } else {
+                return policy_detail::compound<policy_detail::sub_op>(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T mul(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                using U = policy_detail::wrap_type<T>;
+                return static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<T>(a * b);
+            } else {
+                return policy_detail::compound<policy_detail::mul_op>(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T div(const T& a, const T& b) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return static_cast<T>(a / b);
+            } else {
+                return policy_detail::compound<policy_detail::div_op>(a, b);
+            }
+        }
+    };
+
+    struct saturate_policy {
+        template<typename T>
+        static constexpr bool nothrow = true;
+
+        template<typename T>
+        static constexpr T add(const T& a, const T& b) {
+            if constexpr (policy_detail::is_narrow_v<T>) {
+                return policy_detail::clamp_to<T>(static_cast<int>(a) + static_cast<int>(b));
+            } else if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                return policy_detail::add_fits(a, b, out) ? out : policy_detail::saturate_limit<T>(b < 0);
+            } else {
+                return wrap_policy::add(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T sub(const T& a, const T& b) {
+            if constexpr (policy_detail::is_narrow_v<T>) {
+                return policy_detail::clamp_to<T>(static_cast<int>(a) - static_cast<int>(b));
+            } else if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                return policy_detail::sub_fits(a, b, out) ? out : policy_detail::saturate_limit<T>(b > 0);
+            } else {
+                return wrap_policy::sub(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T mul(const T& a, const T& b) {
+            if constexpr (policy_detail::is_narrow_v<T>) {
+                return policy_detail::clamp_to<T>(static_cast<policy_detail::product_type<T>>(a) * static_cast<policy_detail::product_type<T>>(b));
+            } else if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                return policy_detail::mul_fits(a, b, out) ? out : policy_detail::saturate_limit<T>((a < 0) != (b < 0));
+            } else {
+                return wrap_policy::mul(a, b);
+            }
+        }
+
+        // Integer division by zero saturates towards the sign of the dividend (0 / 0 gives 0)
+        template<typename T>
+        static constexpr T div(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                if (b == 0) {
+                    return a == 0 ? T(0) : policy_detail::saturate_limit<T>(a < 0);
+                }
+                T out{};
+                return policy_detail::div_fits(a, b, out) ? out : (std::numeric_limits<T>::max)();
+            } else {
+                return wrap_policy::div(a, b);
+            }
+        }
+    };
+
+    struct checked_policy {
+        template<typename T>
+        static constexpr bool nothrow = !policy_detail::is_integer_v<T>;
+
+        template<typename T>
+        static constexpr T add(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                if (!policy_detail::add_fits(a, b, out)) {
+                    throw std::overflow_error("dmopex: integer overflow in operator+");
+                }
+                return out;
+            } else {
+                return wrap_policy::add(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T sub(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                if (!policy_detail::sub_fits(a, b, out)) {
+                    throw std::overflow_error("dmopex: integer overflow in operator-");
+                }
+                return out;
+            } else {
+                return wrap_policy::sub(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T mul(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                T out{};
+                if (!policy_detail::mul_fits(a, b, out)) {
+                    throw std::overflow_error("dmopex: integer overflow in operator*");
+                }
+                return out;
+            } else {
+                return wrap_policy::mul(a, b);
+            }
+        }
+
+        template<typename T>
+        static constexpr T div(const T& a, const T& b) {
+            if constexpr (policy_detail::is_integer_v<T>) {
+                if (b == 0) {
+                    throw std::domain_error("dmopex: integer division by zero in operator/");
+                }
+                T out{};
+                if (!policy_detail::div_fits(a, b, out)) {
+                    throw std::overflow_error("dmopex: integer overflow in operator/");
+                }
+                return out;
+            } else {
+                return wrap_policy::div(a, b);
+            }
+        }
+    };
+
+    namespace policy_detail {
+        template<typename T, typename = void>
+        struct intrusive_policy {
+            using type = void;
+        };
+
+        template<typename T>
+        struct intrusive_policy<T, std::void_t<typename T::operator_policy>> {
+            using type = typename T::operator_policy;
+        };
+
+        template<typename T, typename = void>
+        struct traits_policy {
+            using type = typename intrusive_policy<T>::type;
+        };
+
+        template<typename T>
+        struct traits_policy<T, std::void_t<typename ::struct_access_traits<T>::operator_policy>> {
+            using type = typename ::struct_access_traits<T>::operator_policy;
+        };
+    } // namespace policy_detail
+
+    // Policy a reflected struct was registered with, wrap_policy when none was given
+    template<typename T>
+    struct policy_of {
+        using type = std::conditional_t<std::is_void_v<typename policy_detail::traits_policy<T>::type>,
+            wrap_policy, typename policy_detail::traits_policy<T>::type>;
+    };
+
+    template<typename T>
+    using policy_of_t = typename policy_of<T>::type;
+
+    namespace policy_detail {
+        // Type of a leaf of leaf_fields_t<T> and the policy of the struct declaring it
+        template<typename Path>
+        struct leaf_info;
+
+        template<auto... P>
+        struct leaf_info<field_path<P...>> {
+            using pointer = fields_detail::member_pointer<std::tuple_element_t<sizeof...(P) - 1, std::tuple<decltype(P)...>>>;
+            using type = typename pointer::member_type;
+            using policy = policy_of_t<typename pointer::class_type>;
+        };
+
+        template<typename P, typename T, typename = void>
+        struct declared_nothrow : std::false_type {};
+
+        template<typename P, typename T>
+        struct declared_nothrow<P, T, std::enable_if_t<P::template nothrow<T>>> : std::true_type {};
+
+        template<typename Op, typename P, typename T>
+        constexpr bool nothrow_leaves();
+
+        template<typename Op, typename T, std::size_t... I>
+        constexpr bool nothrow_members(std::index_sequence<I...>) {
+            return (policy_detail::nothrow_leaves<Op, policy_of_t<T>, std::remove_cv_t<typename fields<T>::template type<I>>>() && ...);
+        }
+
+        // Whether Op under policy P cannot throw for any leaf of T: reflected members with the
+        // policy of their own struct, arrays element by element, other types by their operator
+        template<typename Op, typename P, typename T>
+        constexpr bool nothrow_leaves() {
+            if constexpr (is_reflected_v<T>) {
+                return policy_detail::nothrow_members<Op, T>(std::make_index_sequence<fields<T>::size>{});
+            } else if constexpr (fields_detail::is_array_v<T>) {
+                return policy_detail::nothrow_leaves<Op, P, typename fields_detail::array_traits<std::remove_cv_t<T>>::element_type>();
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return declared_nothrow<P, T>::value;
+            } else {
+                return fields_detail::nothrow_expr<Op::template plain_noexcept, T>::value;
+            }
+        }
+
+        // noexcept specification of the generated operator for Op on T, copies included
+        template<typename Op, typename T>
+        inline constexpr bool nothrow_v = std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T> &&
+            policy_detail::nothrow_leaves<Op, policy_of_t<T>, T>();
+
+        // Same from the member types listed in the macro: a noexcept specification inside the
+        // struct is evaluated before the field metadata of the struct can be
+        template<typename Op, typename P, typename T, typename... M>
+        inline constexpr bool nothrow_members_v = std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T> &&
+            (policy_detail::nothrow_leaves<Op, P, std::remove_cv_t<M>>() && ...);
+    } // namespace policy_detail
+} // namespace dmopex
+
+#endif // __DMOPEX_POLICY_H_INCLUDE__
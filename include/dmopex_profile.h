@@ -0,0 +1,321 @@
+﻿#ifndef __DMOPEX_PROFILE_H_INCLUDE__
+#define __DMOPEX_PROFILE_H_INCLUDE__
+
+// Operator call counts per reflected type, to find the hot types of a production build:
+//
+//   g++ -DDMOPEX_PROFILE ...                 // -DDMOPEX_PROFILE_CYCLES=64 also times calls
+//   dmopex::profile_dump(std::cout);         // type, operator, calls, cycles per call
+//
+// With DMOPEX_PROFILE, every + - * / and == of DEFINE_STRUCT_OPERATORS and
+// DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE types adds one to a counter of the calling thread
+// (compound assignments and != count as the operator they call). The counters are
+// relaxed atomics written by their thread only, so counting takes no lock and shares no
+// cache line. DMOPEX_PROFILE_CYCLES=N, a power of two, also reads the time stamp counter
+// around one call in N of each type, operator and thread (steady_clock nanoseconds where
+// there is no time stamp counter). Calls made during constant evaluation are not counted.
+// Counts of exited threads are kept. Define the switches for the whole program.
+//
+// Without DMOPEX_PROFILE nothing changes: DMOPEX_PROFILE_CALL expands to the operation
+// alone, so the operators compile to the same code as before, and the header only adds
+// that macro and no-op profile_dump and profile_reset; the registry and its standard
+// headers stay out of the translation unit. profile_snapshot and profile_entry exist
+// only with DMOPEX_PROFILE.
+//
+// DMOPEX_PROFILE_MAX_TYPES (default 128) bounds the number of types counted apart; further
+// types share the last entry, "(other types)".
+
+#if !defined(DMOPEX_PROFILE)
+
+#include <iosfwd>
+
+#define DMOPEX_PROFILE_CALL(T, op, ...) __VA_ARGS__
+
+namespace dmopex {
+    inline void profile_dump(std::ostream&) {}
+
+    inline void profile_reset() {}
+} // namespace dmopex
+
+#else
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+#if defined(DMOPEX_PROFILE_CYCLES) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define DMOPEX_PROFILE_RDTSC 1
+#endif
+
+#ifndef DMOPEX_PROFILE_MAX_TYPES
+#   define DMOPEX_PROFILE_MAX_TYPES 128
+#endif
+
+#if defined(__cpp_lib_is_constant_evaluated)
+#   define DMOPEX_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#   define DMOPEX_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+// The value of the operation __VA_ARGS__, counted as operator op of type T
+#define DMOPEX_PROFILE_CALL(T, op, ...) \
+    (DMOPEX_CONSTANT_EVALUATED() ? (__VA_ARGS__) : \
+        ::dmopex::profile_detail::call<T, ::dmopex::profile_op::op>([&] { return __VA_ARGS__; }))
+
+template<typename T>
+struct struct_access_traits;
+
+namespace dmopex {
+    enum class profile_op : unsigned char {
+        add,
+        sub,
+        mul,
+        div,
+        equal,
+    };
+
+    inline constexpr std::size_t profile_op_count = 5;
+
+    constexpr std::string_view to_string(profile_op op) noexcept {
+        constexpr std::string_view names[profile_op_count] = { "+", "-", "*", "/", "==" };
+        return names[static_cast<std::size_t>(op)];
+    }
+
+    // Totals of one (type, operator) over all threads
+    struct profile_entry {
+        std::string_view type;
+        profile_op op;
+        std::uint64_t calls;
+        // Calls timed under DMOPEX_PROFILE_CYCLES and the ticks they took
+        std::uint64_t sampled;
+        std::uint64_t cycles;
+    };
+
+    namespace profile_detail {
+        inline constexpr std::size_t max_types = DMOPEX_PROFILE_MAX_TYPES;
+
+        static_assert(max_types >= 2, "DMOPEX_PROFILE_MAX_TYPES must leave room for the shared entry");
+
+        struct counter {
+            std::atomic<std::uint64_t> calls{ 0 };
+            std::atomic<std::uint64_t> sampled{ 0 };
+            std::atomic<std::uint64_t> cycles{ 0 };
+        };
+
+        // Only its own thread adds to the counters: a relaxed load and store, no locked add
+        inline void bump(std::atomic<std::uint64_t>& value, std::uint64_t n) noexcept {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        struct thread_table;
+
+        class registry {
+        public:
+            static registry& instance() {
+                static registry r;
+                return r;
+            }
+
+            std::size_t add_type(std::string_view name) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (types_.size() == max_types - 1) {
+                    types_.push_back("(other types)");
+                }
+                if (types_.size() == max_types) {
+                    return max_types - 1;
+                }
+                types_.push_back(name);
+                return types_.size() - 1;
+            }
+
+            void attach(const thread_table* table) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                threads_.push_back(table);
+            }
+
+            // Keeps the counts of an exiting thread
+            inline void detach(const thread_table* table);
+
+            inline std::vector<profile_entry> snapshot();
+
+            inline void reset();
+
+        private:
+            struct totals {
+                std::uint64_t calls = 0;
+                std::uint64_t sampled = 0;
+                std::uint64_t cycles = 0;
+            };
+
+            registry() = default;
+
+            std::mutex mutex_;
+            std::vector<std::string_view> types_;
+            std::vector<const thread_table*> threads_;
+            std::array<std::array<totals, profile_op_count>, max_types> retired_{};
+        };
+
+        struct thread_table {
+            counter counters[max_types][profile_op_count];
+
+            thread_table() { registry::instance().attach(this); }
+            ~thread_table() { registry::instance().detach(this); }
+
+            thread_table(const thread_table&) = delete;
+            thread_table& operator=(const thread_table&) = delete;
+        };
+
+        inline void registry::detach(const thread_table* table) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t t = 0; t < max_types; ++t) {
+                for (std::size_t op = 0; op < profile_op_count; ++op) {
+                    const counter& c = table->counters[t][op];
+                    retired_[t][op].calls += c.calls.load(std::memory_order_relaxed);
+                    retired_[t][op].sampled += c.sampled.load(std::memory_order_relaxed);
+                    retired_[t][op].cycles += c.cycles.load(std::memory_order_relaxed);
+                }
+            }
+            threads_.erase(std::find(threads_.begin(), threads_.end(), table));
+        }
+
+        inline std::vector<profile_entry> registry::snapshot() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<profile_entry> result;
+            for (std::size_t t = 0; t < types_.size(); ++t) {
+                for (std::size_t op = 0; op < profile_op_count; ++op) {
+                    profile_entry entry{ types_[t], static_cast<profile_op>(op),
+                        retired_[t][op].calls, retired_[t][op].sampled, retired_[t][op].cycles };
+                    for (const thread_table* table : threads_) {
+                        const counter& c = table->counters[t][op];
+                        entry.calls += c.calls.load(std::memory_order_relaxed);
+                        entry.sampled += c.sampled.load(std::memory_order_relaxed);
+                        entry.cycles += c.cycles.load(std::memory_order_relaxed);
+                    }
+                    if (entry.calls != 0) {
+                        result.push_back(entry);
+                    }
+                }
+            }
+            return result;
+        }
+
+        inline void registry::reset() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            retired_ = {};
+            for (const thread_table* table : threads_) {
+                for (auto& row : const_cast<thread_table*>(table)->counters) {
+                    for (counter& c : row) {
+                        c.calls.store(0, std::memory_order_relaxed);
+                        c.sampled.store(0, std::memory_order_relaxed);
+                        c.cycles.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        inline thread_table& local_table() {
+            thread_local thread_table table;
+            return table;
+        }
+
+        // The pointer needs no initialization guard, unlike the table itself
+        inline thread_table& local() {
+            thread_local thread_table* cached = nullptr;
+            if (cached == nullptr) {
+                cached = &profile_detail::local_table();
+            }
+            return *cached;
+        }
+
+        // Name given to DEFINE_STRUCT_OPERATORS or DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE
+        template<typename T, typename = void>
+        struct name_of {
+            static constexpr std::string_view value = "(unnamed)";
+        };
+
+        template<typename T>
+        struct name_of<T, std::void_t<decltype(T::type_name())>> {
+            static constexpr std::string_view value = T::type_name();
+        };
+
+        template<typename T>
+        struct name_of<T, std::void_t<decltype(::struct_access_traits<T>::type_name())>> {
+            static constexpr std::string_view value = ::struct_access_traits<T>::type_name();
+        };
+
+        template<typename T>
+        std::size_t slot() {
+            static const std::size_t index = registry::instance().add_type(name_of<T>::value);
+            return index;
+        }
+
+        inline std::uint64_t ticks() noexcept {
+#if defined(DMOPEX_PROFILE_RDTSC)
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        template<typename T, profile_op Op, typename F>
+        auto call(F&& f) {
+            counter& c = local().counters[slot<T>()][static_cast<std::size_t>(Op)];
+            const std::uint64_t n = c.calls.load(std::memory_order_relaxed);
+            c.calls.store(n + 1, std::memory_order_relaxed);
+#if defined(DMOPEX_PROFILE_CYCLES)
+            static_assert(DMOPEX_PROFILE_CYCLES > 0 && (DMOPEX_PROFILE_CYCLES & (DMOPEX_PROFILE_CYCLES - 1)) == 0,
+                "DMOPEX_PROFILE_CYCLES must be a power of two");
+            if ((n & (DMOPEX_PROFILE_CYCLES - 1)) == 0) {
+                const std::uint64_t start = ticks();
+                auto result = f();
+                const std::uint64_t stop = ticks();
+                profile_detail::bump(c.sampled, 1);
+                profile_detail::bump(c.cycles, stop - start);
+                return result;
+            }
+#endif
+            return f();
+        }
+    } // namespace profile_detail
+
+    // Counts so far, summed over threads, most called first
+    inline std::vector<profile_entry> profile_snapshot() {
+        std::vector<profile_entry> entries = profile_detail::registry::instance().snapshot();
+        std::stable_sort(entries.begin(), entries.end(), [](const profile_entry& a, const profile_entry& b) {
+            return a.calls > b.calls;
+        });
+        return entries;
+    }
+
+    // One line per (type, operator): type, operator, calls and, when timed, ticks per call
+    inline void profile_dump(std::ostream& os) {
+        for (const profile_entry& entry : profile_snapshot()) {
+            os << entry.type << ' ' << to_string(entry.op) << ' ' << entry.calls;
+            if (entry.sampled != 0) {
+                os << ' ' << static_cast<double>(entry.cycles) / static_cast<double>(entry.sampled);
+            }
+            os << '\n';
+        }
+    }
+
+    // Zeroes the counters; counts of threads calling operators meanwhile may be lost
+    inline void profile_reset() {
+        profile_detail::registry::instance().reset();
+    }
+} // namespace dmopex
+
+#endif // DMOPEX_PROFILE
+
+#endif // __DMOPEX_PROFILE_H_INCLUDE__
@@ -0,0 +1,186 @@
+﻿#ifndef __DMOPEX_PROJECT_H_INCLUDE__
+#define __DMOPEX_PROJECT_H_INCLUDE__
+
+#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "dmopex_hash.h"
+#include "dmopex_span.h"
+#include "dmopex_policy.h"
+
+// Compile-time member subsets. Only the listed members are read or written, the
+// other members of the struct are never touched:
+//
+//   dmopex::project<&Entity::x, &Entity::y>(e) += dmopex::project<&Entity::x, &Entity::y>(velocity);
+//   dmopex::project<&Entity::id>(a) == dmopex::project<&Entity::id>(b);
+//   dmopex::hash(dmopex::project<&Entity::id>(e));
+//   dmopex::batch_add<&Entity::x, &Entity::y>(positions, velocities, positions);
+//
+// Arithmetic follows the arithmetic policy of the struct (see dmopex_policy.h).
+
+namespace dmopex {
+    namespace project_detail {
+        template<auto Member>
+        using class_of = typename fields_detail::member_pointer<decltype(Member)>::class_type;
+
+        template<typename T, auto... Members>
+        inline constexpr bool members_of_v = sizeof...(Members) > 0 &&
+            (std::is_member_object_pointer_v<decltype(Members)> && ...) &&
+            (std::is_base_of_v<class_of<Members>, T> && ...);
+
+        // Three-way comparison; arrays compare lexicographically
+        template<typename M>
+        constexpr int compare(const M& a, const M& b) {
+            if constexpr (fields_detail::is_array_v<M>) {
+                for (std::size_t k = 0; k < fields_detail::array_traits<M>::size; ++k) {
+                    if (int order = project_detail::compare(a[k], b[k])) {
+                        return order;
+                    }
+                }
+                return 0;
+            } else {
+                return a < b ? -1 : (b < a ? 1 : 0);
+            }
+        }
+    } // namespace project_detail
+
+    // View over the members Members... of an object; Object is const for read-only views
+    template<typename Object, auto... Members>
+    class projected {
+    public:
+        using value_type = std::remove_const_t<Object>;
+        static constexpr std::size_t size = sizeof...(Members);
+
+        static_assert(project_detail::members_of_v<value_type, Members...>,
+            "dmopex::project expects pointers to data members of the projected struct");
+
+        constexpr explicit projected(Object& obj) noexcept : obj_(&obj) {}
+
+        constexpr Object& object() const noexcept { return *obj_; }
+
+        // References to the projected members, in projection order
+        constexpr auto tie() const noexcept { return std::tie(obj_->*Members...); }
+
+        template<std::size_t I>
+        constexpr auto& get() const noexcept { return std::get<I>(tie()); }
+
+        template<typename Other>
+        projected& operator+=(const projected<Other, Members...>& other) { return assign(other.object(), add_op{}); }
+        template<typename Other>
+        projected& operator-=(const projected<Other, Members...>& other) { return assign(other.object(), sub_op{}); }
+        template<typename Other>
+        projected& operator*=(const projected<Other, Members...>& other) { return assign(other.object(), mul_op{}); }
+        template<typename Other>
+        projected& operator/=(const projected<Other, Members...>& other) { return assign(other.object(), div_op{}); }
+
+        // Takes the projected members of a whole struct
+        projected& operator+=(const value_type& other) { return assign(other, add_op{}); }
+        projected& operator-=(const value_type& other) { return assign(other, sub_op{}); }
+        projected& operator*=(const value_type& other) { return assign(other, mul_op{}); }
+        projected& operator/=(const value_type& other) { return assign(other, div_op{}); }
+
+        template<typename Other>
+        constexpr bool operator==(const projected<Other, Members...>& other) const { return fields_detail::tuple_equal(tie(), other.tie()); }
+        template<typename Other>
+        constexpr bool operator!=(const projected<Other, Members...>& other) const { return !(*this == other); }
+        template<typename Other>
+        constexpr bool operator<(const projected<Other, Members...>& other) const {
+            int order = 0;
+            ((order = order != 0 ? order : project_detail::compare(obj_->*Members, other.object().*Members)), ...);
+            return order < 0;
+        }
+
+    private:
+        using policy = policy_of_t<value_type>;
+
+        using add_op = policy_detail::add_op;
+        using sub_op = policy_detail::sub_op;
+        using mul_op = policy_detail::mul_op;
+        using div_op = policy_detail::div_op;
+
+        template<typename Op>
+        projected& assign(const value_type& other, Op) {
+            static_assert(!std::is_const_v<Object>, "cannot assign through a projection of a const object");
+            (policy_detail::assign<Op, policy>(obj_->*Members, obj_->*Members, other.*Members), ...);
+            return *this;
+        }
+
+        Object* obj_;
+    };
+
+    template<auto... Members, typename Object>
+    constexpr projected<Object, Members...> project(Object& obj) noexcept {
+        return projected<Object, Members...>(obj);
+    }
+
+    // Hash of the projected members only
+    template<typename Object, auto... Members>
+    std::size_t hash(const projected<Object, Members...>& p) {
+        std::size_t seed = 0;
+        ((seed = hash_detail::combine(seed, dmopex::hash(p.object().*Members))), ...);
+        return seed;
+    }
+
+    // Function objects for hashed and ordered containers keyed on a member subset:
+    //   std::unordered_set<Entity, dmopex::projected_hash<&Entity::id>, dmopex::projected_equal<&Entity::id>>
+    template<auto... Members>
+    struct projected_hash {
+        template<typename T>
+        std::size_t operator()(const T& obj) const { return dmopex::hash(dmopex::project<Members...>(obj)); }
+    };
+
+    template<auto... Members>
+    struct projected_equal {
+        template<typename T>
+        bool operator()(const T& a, const T& b) const { return dmopex::project<Members...>(a) == dmopex::project<Members...>(b); }
+    };
+
+    template<auto... Members>
+    struct projected_less {
+        template<typename T>
+        bool operator()(const T& a, const T& b) const { return dmopex::project<Members...>(a) < dmopex::project<Members...>(b); }
+    };
+
+    namespace project_detail {
+        template<typename Op, typename T, auto... Members>
+        void batch_apply(span<const T> a, span<const T> b, span<T> out) {
+            using policy = policy_of_t<T>;
+            assert(a.size() == b.size() && out.size() >= a.size());
+            const T* x = a.data();
+            const T* y = b.data();
+            T* z = out.data();
+            for (std::size_t i = 0, n = a.size(); i < n; ++i) {
+                (policy_detail::assign<Op, policy>(z[i].*Members, x[i].*Members, y[i].*Members), ...);
+            }
+        }
+    } // namespace project_detail
+
+    // out[i].m = a[i].m op b[i].m for the listed members only, other members of out are left as they are
+    template<auto Member, auto... Members>
+    void batch_add(span<const project_detail::class_of<Member>> a, span<const project_detail::class_of<Member>> b,
+        span<project_detail::class_of<Member>> out) {
+        project_detail::batch_apply<policy_detail::add_op, project_detail::class_of<Member>, Member, Members...>(a, b, out);
+    }
+
+    template<auto Member, auto... Members>
+    void batch_sub(span<const project_detail::class_of<Member>> a, span<const project_detail::class_of<Member>> b,
+        span<project_detail::class_of<Member>> out) {
+        project_detail::batch_apply<policy_detail::sub_op, project_detail::class_of<Member>, Member, Members...>(a, b, out);
+    }
+
+    template<auto Member, auto... Members>
+    void batch_mul(span<const project_detail::class_of<Member>> a, span<const project_detail::class_of<Member>> b,
+        span<project_detail::class_of<Member>> out) {
+        project_detail::batch_apply<policy_detail::mul_op, project_detail::class_of<Member>, Member, Members...>(a, b, out);
+    }
+
+    template<auto Member, auto... Members>
+    void batch_div(span<const project_detail::class_of<Member>> a, span<const project_detail::class_of<Member>> b,
+        span<project_detail::class_of<Member>> out) {
+        project_detail::batch_apply<policy_detail::div_op, project_detail::class_of<Member>, Member, Members...>(a, b, out);
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_PROJECT_H_INCLUDE__
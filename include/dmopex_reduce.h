@@ -0,0 +1,280 @@
+﻿#ifndef __DMOPEX_REDUCE_H_INCLUDE__
+#define __DMOPEX_REDUCE_H_INCLUDE__
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_batch.h"
+
+// Horizontal reductions over the leaf members of a value, generated from the member list:
+//
+//   float s = dmopex::sum_members(v);              // v.x + v.y + v.z
+//   float d = dmopex::dot(a, b);                   // a.x * b.x + a.y * b.y + a.z * b.z
+//   float l = dmopex::length_squared(v);           // dot(v, v)
+//   float r = dmopex::distance_squared(a, b);      // length_squared(a - b) without the temporary
+//   float m = dmopex::min_member(v);               // also max_member
+//   dmopex::batch_dot<Vector3D>(a, b, out);        // out[i] = dot(a[i], b[i])
+//
+// Works on reflected structs (nested members and arrays included), arrays and plain
+// arithmetic values. Sums are computed in the common type of the leaves, at least int, with
+// plain arithmetic: the struct's policy does not apply. Leaves are added in declaration order.
+// The batch versions process structs of 1 to 4 float leaves without padding (Vector2D,
+// Vector3D, quaternions, ...) four elements at a time with SSE2 or NEON, transposing the
+// interleaved leaves in registers; other types go element by element.
+
+namespace dmopex {
+    namespace reduce_detail {
+        template<typename Leaves>
+        struct leaves_common;
+
+        template<typename... Path>
+        struct leaves_common<std::tuple<Path...>> {
+            using type = std::common_type_t<typename fields_detail::scalar_of<typename policy_detail::leaf_info<Path>::type>::type...>;
+        };
+
+        template<typename T, typename = void>
+        struct leaf_common {
+            using type = typename fields_detail::scalar_of<T>::type;
+        };
+
+        template<typename T>
+        struct leaf_common<T, std::enable_if_t<is_reflected_v<T>>> {
+            using type = typename leaves_common<leaf_fields_t<T>>::type;
+        };
+
+        // Common type of the leaves of T, the result of min_member / max_member
+        template<typename T>
+        using leaf_t = typename leaf_common<T>::type;
+
+        // Type sums and products of the leaves of T are computed in
+        template<typename T>
+        using sum_t = std::common_type_t<leaf_t<T>, int>;
+
+        // Leaf terms of the reductions, summed over all leaves
+        struct value_term {
+            template<typename C, typename M>
+            static C apply(const M& a) { return C(a); }
+        };
+
+        struct product_term {
+            template<typename C, typename M>
+            static C apply(const M& a, const M& b) { return C(a) * C(b); }
+        };
+
+        struct squared_difference_term {
+            template<typename C, typename M>
+            static C apply(const M& a, const M& b) {
+                if constexpr (std::is_unsigned_v<C>) {
+                    // a - b would wrap for a < b
+                    const C d = a < b ? C(b) - C(a) : C(a) - C(b);
+                    return d * d;
+                } else {
+                    const C d = C(a) - C(b);
+                    return d * d;
+                }
+            }
+        };
+
+        template<typename Term, typename C>
+        struct summer {
+            // -0.0 + x is exactly x, so the compiler drops the first addition; 0.0 + -0.0 is not
+            C sum = std::is_floating_point_v<C> ? C(-0.0) : C(0);
+
+            template<typename... M>
+            void operator()(const M&... leaf) { sum += Term::template apply<C>(leaf...); }
+        };
+
+        template<typename Term, typename T, typename... In>
+        sum_t<T> sum_leaves(const T& first, const In&... in) {
+            summer<Term, sum_t<T>> f;
+            fields_detail::visit(f, first, in...);
+            return f.sum;
+        }
+
+        template<bool Max, typename C>
+        struct extremum {
+            C value{};
+            bool first = true;
+
+            template<typename M>
+            void operator()(const M& leaf) {
+                const C v = C(leaf);
+                if (first || (Max ? value < v : v < value)) {
+                    value = v;
+                    first = false;
+                }
+            }
+        };
+
+        // Float leaves per element when T can be reduced four elements at a time, 0 otherwise
+        template<typename T, typename = void>
+        struct float_leaves {
+            static constexpr std::size_t value = std::is_same_v<T, float> ? 1 : 0;
+        };
+
+        template<typename T>
+        struct float_leaves<T, std::enable_if_t<is_reflected_v<T>>> {
+            using layout = batch_detail::flat_layout<T>;
+            static constexpr std::size_t value = layout::value && std::is_same_v<typename layout::leaf_type, float> &&
+                sizeof(T) <= 4 * sizeof(float) ? sizeof(T) / sizeof(float) : 0;
+        };
+
+#if defined(DMOPEX_SIMD_SSE2)
+        struct simd_floats {
+            using vec = __m128;
+
+            static vec term(product_term, const float* x, const float* y) noexcept {
+                return _mm_mul_ps(_mm_loadu_ps(x), _mm_loadu_ps(y));
+            }
+
+            static vec term(squared_difference_term, const float* x, const float* y) noexcept {
+                vec d = _mm_sub_ps(_mm_loadu_ps(x), _mm_loadu_ps(y));
+                return _mm_mul_ps(d, d);
+            }
+
+            // Sums of each group of K consecutive terms for four elements: the K vectors of
+            // interleaved terms are transposed to one vector per leaf, then added in leaf order
+            template<std::size_t K, typename Term>
+            static void store_sums(Term term, const float* x, const float* y, float* z) noexcept {
+                if constexpr (K == 1) {
+                    _mm_storeu_ps(z, term(x, y));
+                } else if constexpr (K == 2) {
+                    vec p0 = term(x, y), p1 = term(x + 4, y + 4);
+                    _mm_storeu_ps(z, _mm_add_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1))));
+                } else if constexpr (K == 3) {
+                    vec p0 = term(x, y), p1 = term(x + 4, y + 4), p2 = term(x + 8, y + 8);
+                    vec l0 = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 3, 0)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 1, 3, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+                    vec l1 = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                    vec l2 = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+                    _mm_storeu_ps(z, _mm_add_ps(_mm_add_ps(l0, l1), l2));
+                } else {
+                    vec p0 = term(x, y), p1 = term(x + 4, y + 4), p2 = term(x + 8, y + 8), p3 = term(x + 12, y + 12);
+                    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                    _mm_storeu_ps(z, _mm_add_ps(_mm_add_ps(_mm_add_ps(p0, p1), p2), p3));
+                }
+            }
+        };
+#elif defined(DMOPEX_SIMD_NEON)
+        struct simd_floats {
+            using vec = float32x4_t;
+
+            static vec term(product_term, vec a, vec b) noexcept { return vmulq_f32(a, b); }
+
+            static vec term(squared_difference_term, vec a, vec b) noexcept {
+                vec d = vsubq_f32(a, b);
+                return vmulq_f32(d, d);
+            }
+
+            // The structure loads deinterleave the leaves, one vector per leaf, added in leaf order
+            template<std::size_t K, typename Term>
+            static void store_sums(Term term, const float* x, const float* y, float* z) noexcept {
+                if constexpr (K == 1) {
+                    vst1q_f32(z, term(vld1q_f32(x), vld1q_f32(y)));
+                } else if constexpr (K == 2) {
+                    float32x4x2_t a = vld2q_f32(x), b = vld2q_f32(y);
+                    vst1q_f32(z, vaddq_f32(term(a.val[0], b.val[0]), term(a.val[1], b.val[1])));
+                } else if constexpr (K == 3) {
+                    float32x4x3_t a = vld3q_f32(x), b = vld3q_f32(y);
+                    vst1q_f32(z, vaddq_f32(vaddq_f32(term(a.val[0], b.val[0]), term(a.val[1], b.val[1])), term(a.val[2], b.val[2])));
+                } else {
+                    float32x4x4_t a = vld4q_f32(x), b = vld4q_f32(y);
+                    vst1q_f32(z, vaddq_f32(vaddq_f32(vaddq_f32(term(a.val[0], b.val[0]), term(a.val[1], b.val[1])),
+                        term(a.val[2], b.val[2])), term(a.val[3], b.val[3])));
+                }
+            }
+        };
+#endif
+
+        // out[i] = sum of Term over the leaves of a[i] and b[i]
+        template<typename Term, typename T>
+        void batch_sum(const T* a, const T* b, sum_t<T>* out, std::size_t n) {
+            std::size_t i = 0;
+#if defined(DMOPEX_SIMD_SSE2) || defined(DMOPEX_SIMD_NEON)
+            constexpr std::size_t K = float_leaves<T>::value;
+            if constexpr (K != 0) {
+                const float* x = reinterpret_cast<const float*>(a);
+                const float* y = reinterpret_cast<const float*>(b);
+                auto term = [](auto... v) { return simd_floats::term(Term{}, v...); };
+                for (; i + 4 <= n; i += 4) {
+                    simd_floats::store_sums<K>(term, x + i * K, y + i * K, out + i);
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                out[i] = reduce_detail::sum_leaves<Term>(a[i], b[i]);
+            }
+        }
+    } // namespace reduce_detail
+
+    template<typename T>
+    reduce_detail::sum_t<T> sum_members(const T& v) {
+        return reduce_detail::sum_leaves<reduce_detail::value_term>(v);
+    }
+
+    template<typename T>
+    reduce_detail::sum_t<T> dot(const T& a, const T& b) {
+        return reduce_detail::sum_leaves<reduce_detail::product_term>(a, b);
+    }
+
+    template<typename T>
+    reduce_detail::sum_t<T> length_squared(const T& v) {
+        return dmopex::dot(v, v);
+    }
+
+    template<typename T>
+    auto length(const T& v) {
+        return std::sqrt(dmopex::length_squared(v));
+    }
+
+    template<typename T>
+    reduce_detail::sum_t<T> distance_squared(const T& a, const T& b) {
+        return reduce_detail::sum_leaves<reduce_detail::squared_difference_term>(a, b);
+    }
+
+    template<typename T>
+    auto distance(const T& a, const T& b) {
+        return std::sqrt(dmopex::distance_squared(a, b));
+    }
+
+    template<typename T>
+    reduce_detail::leaf_t<T> min_member(const T& v) {
+        static_assert(leaf_count_v<T> != 0 || !is_reflected_v<T>, "dmopex::min_member needs at least one member");
+        reduce_detail::extremum<false, reduce_detail::leaf_t<T>> f;
+        fields_detail::visit(f, v);
+        return f.value;
+    }
+
+    template<typename T>
+    reduce_detail::leaf_t<T> max_member(const T& v) {
+        static_assert(leaf_count_v<T> != 0 || !is_reflected_v<T>, "dmopex::max_member needs at least one member");
+        reduce_detail::extremum<true, reduce_detail::leaf_t<T>> f;
+        fields_detail::visit(f, v);
+        return f.value;
+    }
+
+    // Batch versions, out must hold at least a.size() values
+    template<typename T>
+    void batch_dot(span<const T> a, span<const T> b, span<reduce_detail::sum_t<T>> out) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        reduce_detail::batch_sum<reduce_detail::product_term>(a.data(), b.data(), out.data(), a.size());
+    }
+
+    template<typename T>
+    void batch_length_squared(span<const T> a, span<reduce_detail::sum_t<T>> out) {
+        dmopex::batch_dot<T>(a, a, out);
+    }
+
+    template<typename T>
+    void batch_distance_squared(span<const T> a, span<const T> b, span<reduce_detail::sum_t<T>> out) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        reduce_detail::batch_sum<reduce_detail::squared_difference_term>(a.data(), b.data(), out.data(), a.size());
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_REDUCE_H_INCLUDE__
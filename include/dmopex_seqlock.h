@@ -0,0 +1,117 @@
+﻿#ifndef __DMOPEX_SEQLOCK_H_INCLUDE__
+#define __DMOPEX_SEQLOCK_H_INCLUDE__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#endif
+
+// Single-writer / many-reader publication cell:
+//
+//   dmopex::seqlock<Camera> camera;
+//   camera.store(c);                 // simulation thread, every frame
+//   Camera snapshot = camera.load(); // any number of reader threads
+//
+// The writer never waits. Readers copy the value and retry when a store overlapped the
+// copy, so they never observe a torn value and never block the writer. The value is kept
+// in relaxed atomic words ordered by the sequence counter, so the copies are free of
+// data races. Only one thread may call store() at a time.
+
+namespace dmopex {
+    namespace seqlock_detail {
+        inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+            __asm__ __volatile__("yield");
+#endif
+        }
+    } // namespace seqlock_detail
+
+    template<typename T>
+    class seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "dmopex::seqlock requires a trivially copyable type");
+
+        using word = std::uint64_t;
+        static constexpr std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+    public:
+        using value_type = T;
+
+        seqlock() noexcept : seqlock(T{}) {}
+
+        explicit seqlock(const T& value) noexcept {
+            word buffer[word_count] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+            for (std::size_t k = 0; k < word_count; ++k) {
+                words_[k].store(buffer[k], std::memory_order_relaxed);
+            }
+        }
+
+        seqlock(const seqlock&) = delete;
+        seqlock& operator=(const seqlock&) = delete;
+
+        // Writer side, wait-free
+        void store(const T& value) noexcept {
+            word buffer[word_count] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t k = 0; k < word_count; ++k) {
+                words_[k].store(buffer[k], std::memory_order_relaxed);
+            }
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        // Reader side, retries while a store overlaps the copy. Yields after a short spin so a
+        // writer preempted in the middle of a store gets the core back on oversubscribed machines.
+        T load() const noexcept {
+            T value;
+            for (unsigned spins = 0; !try_load(value); ++spins) {
+                if (spins < 64) {
+                    seqlock_detail::cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            return value;
+        }
+
+        // Single attempt: false when a store overlapped the copy, out is then left unchanged
+        bool try_load(T& out) const noexcept {
+            const std::uint64_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                return false;
+            }
+            word buffer[word_count];
+            for (std::size_t k = 0; k < word_count; ++k) {
+                buffer[k] = words_[k].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) != before) {
+                return false;
+            }
+            std::memcpy(&out, buffer, sizeof(T));
+            return true;
+        }
+
+        // Number of completed stores, lets readers skip values they have already seen
+        std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+    private:
+        alignas(64) std::atomic<std::uint64_t> seq_{ 0 };
+        std::atomic<word> words_[word_count];
+    };
+} // namespace dmopex
+
+#endif // __DMOPEX_SEQLOCK_H_INCLUDE__
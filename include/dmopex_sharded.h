@@ -0,0 +1,186 @@
+﻿#ifndef __DMOPEX_SHARDED_H_INCLUDE__
+#define __DMOPEX_SHARDED_H_INCLUDE__
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <type_traits>
+
+// Per-thread accumulators merged on demand:
+//
+//   dmopex::sharded<Telemetry> telemetry;
+//   telemetry += delta;                    // hot path, any thread
+//   Telemetry total = telemetry.collect(); // reporting thread
+//
+// Every thread owns a cache-line aligned shard updated with the struct's own operator+=,
+// so the hot path has no locked instruction and no cache line shared with other threads.
+// collect() adds all shards together with the struct's operator+. The shards are held in
+// relaxed atomic words, so collect() may run while other threads update: each member then
+// reads as some value its shard held (members are never torn), but different members may
+// come from different moments.
+//
+// Shards belong to thread slots that are recycled when a thread exits, so the values
+// accumulated by finished threads stay in the total.
+
+namespace dmopex {
+    namespace sharded_detail {
+        // Dense small indices for the running threads, reused after a thread exits
+        class slot_registry {
+        public:
+            static slot_registry& instance() {
+                static slot_registry registry;
+                return registry;
+            }
+
+            std::size_t acquire() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (free_.empty()) {
+                    return next_++;
+                }
+                std::size_t slot = free_.back();
+                free_.pop_back();
+                return slot;
+            }
+
+            void release(std::size_t slot) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.push_back(slot);
+            }
+
+        private:
+            std::mutex mutex_;
+            std::vector<std::size_t> free_;
+            std::size_t next_ = 0;
+        };
+
+        struct thread_slot {
+            // Keeps the registry alive until every thread_slot has been released
+            slot_registry& registry = slot_registry::instance();
+            std::size_t index = registry.acquire();
+
+            ~thread_slot() { registry.release(index); }
+        };
+
+        inline std::size_t current_slot() {
+            static thread_local thread_slot slot;
+            return slot.index;
+        }
+    } // namespace sharded_detail
+
+    template<typename T>
+    class sharded {
+        static_assert(std::is_trivially_copyable_v<T>, "dmopex::sharded requires a trivially copyable type");
+
+        using word = std::uint64_t;
+        static constexpr std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+        struct alignas(64) shard {
+            std::atomic<word> words[word_count];
+
+            T load() const noexcept {
+                word buffer[word_count];
+                for (std::size_t k = 0; k < word_count; ++k) {
+                    buffer[k] = words[k].load(std::memory_order_relaxed);
+                }
+                T value;
+                std::memcpy(&value, buffer, sizeof(T));
+                return value;
+            }
+
+            void store(const T& value) noexcept {
+                word buffer[word_count] = {};
+                std::memcpy(buffer, &value, sizeof(T));
+                for (std::size_t k = 0; k < word_count; ++k) {
+                    words[k].store(buffer[k], std::memory_order_relaxed);
+                }
+            }
+        };
+
+        static constexpr std::size_t chunk_size = 64;
+        static constexpr std::size_t max_chunks = 256;
+
+        struct chunk {
+            shard shards[chunk_size];
+
+            chunk() noexcept {
+                for (auto& s : shards) {
+                    s.store(T{});
+                }
+            }
+        };
+
+    public:
+        using value_type = T;
+
+        sharded() noexcept = default;
+
+        sharded(const sharded&) = delete;
+        sharded& operator=(const sharded&) = delete;
+
+        ~sharded() {
+            for (auto& c : chunks_) {
+                delete c.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Hot path: updates the calling thread's shard
+        sharded& operator+=(const T& value) {
+            update([&](T& local) { local += value; });
+            return *this;
+        }
+
+        sharded& operator-=(const T& value) {
+            update([&](T& local) { local -= value; });
+            return *this;
+        }
+
+        // Calls f(T&) on the calling thread's shard
+        template<typename F>
+        void update(F&& f) {
+            shard& s = local();
+            T value = s.load();
+            f(value);
+            s.store(value);
+        }
+
+        // Sum of all shards
+        T collect() const {
+            T total{};
+            for (const auto& c : chunks_) {
+                const chunk* p = c.load(std::memory_order_acquire);
+                if (p == nullptr) {
+                    continue;
+                }
+                for (const auto& s : p->shards) {
+                    total = total + s.load();
+                }
+            }
+            return total;
+        }
+
+    private:
+        shard& local() {
+            const std::size_t slot = sharded_detail::current_slot();
+            assert(slot < chunk_size * max_chunks && "dmopex::sharded supports 16384 simultaneously running threads");
+            std::atomic<chunk*>& entry = chunks_[slot / chunk_size];
+            chunk* p = entry.load(std::memory_order_acquire);
+            if (p == nullptr) {
+                chunk* created = new chunk();
+                if (entry.compare_exchange_strong(p, created, std::memory_order_acq_rel)) {
+                    p = created;
+                } else {
+                    delete created;
+                }
+            }
+            return p->shards[slot % chunk_size];
+        }
+
+        std::atomic<chunk*> chunks_[max_chunks] = {};
+    };
+} // namespace dmopex
+
+#endif // __DMOPEX_SHARDED_H_INCLUDE__
@@ -0,0 +1,76 @@
+﻿#ifndef __DMOPEX_SPAN_H_INCLUDE__
+#define __DMOPEX_SPAN_H_INCLUDE__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace dmopex {
+    // Minimal non-owning view over contiguous elements (std::span is C++20 only)
+    template<typename T>
+    class span {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        constexpr span() noexcept = default;
+
+        constexpr span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+        template<std::size_t N>
+        constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+
+        template<typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<Container&>())), T*>>>
+        constexpr span(Container& c) noexcept : data_(std::data(c)), size_(std::size(c)) {}
+
+        template<typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+        constexpr span(const span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+        constexpr T* data() const noexcept { return data_; }
+        constexpr std::size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr T* begin() const noexcept { return data_; }
+        constexpr T* end() const noexcept { return data_ + size_; }
+
+        constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        constexpr span first(std::size_t count) const noexcept { return span(data_, count); }
+        constexpr span subspan(std::size_t offset, std::size_t count) const noexcept { return span(data_ + offset, count); }
+        constexpr span subspan(std::size_t offset) const noexcept { return span(data_ + offset, size_ - offset); }
+
+    private:
+        T* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    template<typename T>
+    span(T*, std::size_t) -> span<T>;
+
+    template<typename T, std::size_t N>
+    span(T (&)[N]) -> span<T>;
+
+    template<typename Container>
+    span(Container&) -> span<std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>>;
+
+    namespace span_detail {
+        template<typename R>
+        struct is_view : std::false_type {};
+
+        template<typename T>
+        struct is_view<span<T>> : std::true_type {};
+
+        // Whether the elements of a range passed as R outlive the call: lvalues and views do,
+        // the elements of a temporary container are destroyed at the end of the expression
+        template<typename R>
+        inline constexpr bool borrowed_v = std::is_lvalue_reference_v<R> || is_view<std::remove_cv_t<std::remove_reference_t<R>>>::value;
+    } // namespace span_detail
+} // namespace dmopex
+
+#endif // __DMOPEX_SPAN_H_INCLUDE__
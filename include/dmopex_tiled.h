@@ -0,0 +1,191 @@
+﻿#ifndef __DMOPEX_TILED_H_INCLUDE__
+#define __DMOPEX_TILED_H_INCLUDE__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_batch.h"
+
+// Batch arithmetic tuned for arrays much larger than the caches:
+//
+//   dmopex::tile_options options;
+//   options.prefetch_bytes = 1024;     // prefetch inputs 1 KiB ahead of the kernel
+//   options.stream_stores = true;      // out is not read again soon: bypass the cache
+//   dmopex::batch_add<Color>(a, b, out, options);
+//
+//   // A chain of passes run tile by tile, so the intermediate arrays stay in L2
+//   dmopex::for_each_tile<Vector3D>(count, options, [&](std::size_t i, std::size_t n) {
+//       dmopex::batch_add<Vector3D>(a.subspan(i, n), b.subspan(i, n), c.subspan(i, n));
+//       dmopex::batch_mul<Vector3D>(c.subspan(i, n), s.subspan(i, n), out.subspan(i, n), options);
+//   });
+//
+// The batch functions taking a tile_options run the same kernels as dmopex_batch.h over
+// blocks of 4 KiB. Before each block, the lines of the inputs prefetch_bytes further on
+// are prefetched. With stream_stores, each block is computed into a buffer on the stack
+// and copied to out with non-temporal stores, which skip reading the lines of out into the
+// cache before writing them; this needs a trivially copyable T and SSE2, elsewhere out is
+// written normally. Results are the same as with the plain batch functions. Which settings
+// pay off depends on the machine, bench/dmopextiledbench measures them.
+
+namespace dmopex {
+    struct tile_options {
+        // Bytes of each array per tile of for_each_tile. The arrays of a chain of passes
+        // should fit L2 together.
+        std::size_t tile_bytes = 64 * 1024;
+        // Distance ahead of the current block at which inputs are prefetched, 0 for none
+        std::size_t prefetch_bytes = 0;
+        // Write out with non-temporal stores, for outputs not read again soon
+        bool stream_stores = false;
+    };
+
+    namespace tiled_detail {
+        inline constexpr std::size_t line_bytes = 64;
+
+        constexpr std::size_t gcd(std::size_t a, std::size_t b) { return b == 0 ? a : gcd(b, a % b); }
+
+        // Elements per block: about 4 KiB of T, a whole number of cache lines when T allows,
+        // so that blocks written with non-temporal stores do not share lines
+        template<typename T>
+        inline constexpr std::size_t lines_unit_v = line_bytes / gcd(sizeof(T), line_bytes);
+
+        template<typename T>
+        inline constexpr std::size_t block_v = 4096 / sizeof(T) < lines_unit_v<T> ? (4096 / sizeof(T) == 0 ? 1 : 4096 / sizeof(T)) :
+            4096 / sizeof(T) / lines_unit_v<T> * lines_unit_v<T>;
+
+        template<bool Write>
+        inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p, Write ? 1 : 0, 3);
+#elif defined(DMOPEX_SIMD_SSE2)
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+
+        // Prefetches the lines of [first, last) clipped to the array [data, data + n)
+        template<bool Write, typename T>
+        void prefetch_range(const T* data, std::size_t n, std::size_t first, std::size_t last) noexcept {
+            if (first >= n) {
+                return;
+            }
+            const char* begin = reinterpret_cast<const char*>(data + first);
+            const char* end = reinterpret_cast<const char*>(data + (last < n ? last : n));
+            for (const char* p = begin; p < end; p += line_bytes) {
+                tiled_detail::prefetch<Write>(p);
+            }
+        }
+
+        inline constexpr bool has_stream_stores =
+#if defined(DMOPEX_SIMD_SSE2)
+            true;
+#else
+            false;
+#endif
+
+        // memcpy with non-temporal stores for the 16-byte aligned part of dst
+        inline void stream_copy(void* dst, const void* src, std::size_t bytes) noexcept {
+            char* d = static_cast<char*>(dst);
+            const char* s = static_cast<const char*>(src);
+#if defined(DMOPEX_SIMD_SSE2)
+            const std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16;
+            if (bytes > head) {
+                std::memcpy(d, s, head);
+                d += head;
+                s += head;
+                bytes -= head;
+                for (; bytes >= 64; d += 64, s += 64, bytes -= 64) {
+                    const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                    const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                    const __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+                    const __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d), x0);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), x1);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), x2);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), x3);
+                }
+                for (; bytes >= 16; d += 16, s += 16, bytes -= 16) {
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+                }
+            }
+#endif
+            std::memcpy(d, s, bytes);
+        }
+
+        // Orders the non-temporal stores before the stores that follow, as publishing the
+        // array to another thread
+        inline void stream_fence() noexcept {
+#if defined(DMOPEX_SIMD_SSE2)
+            _mm_sfence();
+#endif
+        }
+    } // namespace tiled_detail
+
+    // Calls f(first, count) for consecutive ranges of elements covering [0, n), each holding
+    // options.tile_bytes of T
+    template<typename T, typename F>
+    void for_each_tile(std::size_t n, const tile_options& options, F&& f) {
+        const std::size_t tile = options.tile_bytes / sizeof(T) == 0 ? 1 : options.tile_bytes / sizeof(T);
+        for (std::size_t i = 0; i < n; i += tile) {
+            f(i, n - i < tile ? n - i : tile);
+        }
+    }
+
+    template<typename T, typename Op>
+    void batch_apply(span<const T> a, span<const T> b, span<T> out, Op, const tile_options& options) {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        constexpr std::size_t block = tiled_detail::block_v<T>;
+        const std::size_t n = a.size();
+        const std::size_t ahead = options.prefetch_bytes / sizeof(T);
+        const bool stream = tiled_detail::has_stream_stores && std::is_trivially_copyable_v<T> && options.stream_stores;
+        for (std::size_t i = 0; i < n; i += block) {
+            const std::size_t count = n - i < block ? n - i : block;
+            if (options.prefetch_bytes != 0) {
+                tiled_detail::prefetch_range<false>(a.data(), n, i + ahead, i + ahead + count);
+                tiled_detail::prefetch_range<false>(b.data(), n, i + ahead, i + ahead + count);
+                if (!stream) {
+                    tiled_detail::prefetch_range<true>(out.data(), n, i + ahead, i + ahead + count);
+                }
+            }
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (stream) {
+                    T buffer[block];
+                    batch_kernel<T, Op>::apply(a.data() + i, b.data() + i, buffer, count);
+                    tiled_detail::stream_copy(out.data() + i, buffer, count * sizeof(T));
+                    continue;
+                }
+            }
+            batch_kernel<T, Op>::apply(a.data() + i, b.data() + i, out.data() + i, count);
+        }
+        if (stream) {
+            tiled_detail::stream_fence();
+        }
+    }
+
+    template<typename T>
+    void batch_add(span<const T> a, span<const T> b, span<T> out, const tile_options& options) {
+        dmopex::batch_apply(a, b, out, std::plus<>{}, options);
+    }
+
+    template<typename T>
+    void batch_sub(span<const T> a, span<const T> b, span<T> out, const tile_options& options) {
+        dmopex::batch_apply(a, b, out, std::minus<>{}, options);
+    }
+
+    template<typename T>
+    void batch_mul(span<const T> a, span<const T> b, span<T> out, const tile_options& options) {
+        dmopex::batch_apply(a, b, out, std::multiplies<>{}, options);
+    }
+
+    template<typename T>
+    void batch_div(span<const T> a, span<const T> b, span<T> out, const tile_options& options) {
+        dmopex::batch_apply(a, b, out, std::divides<>{}, options);
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_TILED_H_INCLUDE__
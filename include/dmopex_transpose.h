@@ -0,0 +1,335 @@
+﻿#ifndef __DMOPEX_TRANSPOSE_H_INCLUDE__
+#define __DMOPEX_TRANSPOSE_H_INCLUDE__
+
+#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "dmopex_span.h"
+#include "dmopex_fields.h"
+#include "dmopex_batch.h"
+
+// Conversion between an array of structs and one column per leaf member:
+//
+//   std::vector<float> xs(n), ys(n), zs(n);
+//   dmopex::aos_to_soa<Vector3D>(points, { xs.data(), ys.data(), zs.data() });   // xs[i] = points[i].x ...
+//   dmopex::soa_to_aos<Vector3D>({ xs.data(), ys.data(), zs.data() }, points);   // points[i].x = xs[i] ...
+//
+// Columns follow leaf_fields_t<T>: nested reflected members are flattened in declaration
+// order and array members get a column of arrays. Each column must hold at least as many
+// values as the array of structs.
+// Structs of 1 to 4 leaves of one 4-byte or 8-byte type without padding (Vector3D,
+// quaternions, pairs of int, ...) are transposed a register at a time with SSE2 or NEON
+// shuffles; other types are copied leaf by leaf.
+
+namespace dmopex {
+    namespace transpose_detail {
+        template<typename Leaves, typename = void>
+        struct column_pointers;
+
+        template<typename... Path>
+        struct column_pointers<std::tuple<Path...>> {
+            using type = std::tuple<typename policy_detail::leaf_info<Path>::type*...>;
+            using const_type = std::tuple<const typename policy_detail::leaf_info<Path>::type*...>;
+        };
+    } // namespace transpose_detail
+
+    // One pointer per leaf of T, the columns of aos_to_soa / soa_to_aos
+    template<typename T>
+    using columns_t = typename transpose_detail::column_pointers<leaf_fields_t<T>>::type;
+
+    template<typename T>
+    using const_columns_t = typename transpose_detail::column_pointers<leaf_fields_t<T>>::const_type;
+
+    namespace transpose_detail {
+        struct copy_leaf {
+            template<typename M>
+            constexpr M operator()(const M& v) const { return v; }
+        };
+
+        // Leaves of one 4-byte or 8-byte arithmetic type, no arrays and no padding: the array
+        // of structs is a plain array of K interleaved columns
+        template<typename T, typename Leaves = leaf_fields_t<T>>
+        struct interleaved {
+            static constexpr std::size_t leaves = 0;
+        };
+
+        template<typename T, typename First, typename... Rest>
+        struct interleaved<T, std::tuple<First, Rest...>> {
+            using leaf_type = typename policy_detail::leaf_info<First>::type;
+
+            static constexpr bool uniform = std::is_trivially_copyable_v<T> && std::is_arithmetic_v<leaf_type> &&
+                (sizeof(leaf_type) == 4 || sizeof(leaf_type) == 8) &&
+                (std::is_same_v<typename policy_detail::leaf_info<Rest>::type, leaf_type> && ...) &&
+                sizeof(T) == (1 + sizeof...(Rest)) * sizeof(leaf_type);
+
+            static constexpr std::size_t leaves = uniform && sizeof...(Rest) < 4 ? 1 + sizeof...(Rest) : 0;
+
+            // Whether the macro lists the leaves in memory order, checked on one element;
+            // the offsets are constants, so the check folds away
+            static bool in_memory_order(const T& obj) noexcept {
+                return in_memory_order(obj, std::index_sequence_for<First, Rest...>{});
+            }
+
+            template<std::size_t... I>
+            static bool in_memory_order(const T& obj, std::index_sequence<I...>) noexcept {
+                const auto* base = reinterpret_cast<const unsigned char*>(&obj);
+                return ((reinterpret_cast<const unsigned char*>(&std::tuple_element_t<I, std::tuple<First, Rest...>>::get(obj)) ==
+                    base + I * sizeof(leaf_type)) && ...);
+            }
+        };
+
+#if defined(DMOPEX_SIMD_SSE2)
+        template<std::size_t Bytes>
+        struct lanes;
+
+        // Four 4-byte leaves per register, moved as float bit patterns
+        template<>
+        struct lanes<4> {
+            using vec = __m128;
+            static constexpr std::size_t width = 4;
+
+            static vec load(const void* p) noexcept { return _mm_loadu_ps(static_cast<const float*>(p)); }
+            static void store(void* p, vec v) noexcept { _mm_storeu_ps(static_cast<float*>(p), v); }
+
+            // K registers of interleaved leaves from p to one register per leaf
+            template<std::size_t K>
+            static void split(const void* p, vec (&v)[K]) noexcept {
+                const float* x = static_cast<const float*>(p);
+                if constexpr (K == 1) {
+                    v[0] = _mm_loadu_ps(x);
+                } else if constexpr (K == 2) {
+                    vec p0 = _mm_loadu_ps(x), p1 = _mm_loadu_ps(x + 4);
+                    v[0] = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+                    v[1] = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+                } else if constexpr (K == 3) {
+                    vec p0 = _mm_loadu_ps(x), p1 = _mm_loadu_ps(x + 4), p2 = _mm_loadu_ps(x + 8);
+                    v[0] = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 3, 0)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 1, 3, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+                    v[1] = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                    v[2] = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+                } else {
+                    v[0] = _mm_loadu_ps(x), v[1] = _mm_loadu_ps(x + 4), v[2] = _mm_loadu_ps(x + 8), v[3] = _mm_loadu_ps(x + 12);
+                    _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+                }
+            }
+
+            // One register per leaf to K registers of interleaved leaves at p
+            template<std::size_t K>
+            static void merge(const vec (&v)[K], void* p) noexcept {
+                float* z = static_cast<float*>(p);
+                if constexpr (K == 1) {
+                    _mm_storeu_ps(z, v[0]);
+                } else if constexpr (K == 2) {
+                    _mm_storeu_ps(z, _mm_unpacklo_ps(v[0], v[1]));
+                    _mm_storeu_ps(z + 4, _mm_unpackhi_ps(v[0], v[1]));
+                } else if constexpr (K == 3) {
+                    vec xy0 = _mm_unpacklo_ps(v[0], v[1]), xy1 = _mm_unpackhi_ps(v[0], v[1]);
+                    _mm_storeu_ps(z, _mm_shuffle_ps(xy0, _mm_shuffle_ps(v[2], xy0, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+                    _mm_storeu_ps(z + 4, _mm_shuffle_ps(_mm_shuffle_ps(xy0, v[2], _MM_SHUFFLE(1, 1, 3, 3)), xy1, _MM_SHUFFLE(1, 0, 2, 0)));
+                    _mm_storeu_ps(z + 8, _mm_shuffle_ps(_mm_shuffle_ps(v[2], xy1, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xy1, v[2], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+                } else {
+                    vec p0 = v[0], p1 = v[1], p2 = v[2], p3 = v[3];
+                    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                    _mm_storeu_ps(z, p0), _mm_storeu_ps(z + 4, p1), _mm_storeu_ps(z + 8, p2), _mm_storeu_ps(z + 12, p3);
+                }
+            }
+        };
+
+        // Two 8-byte leaves per register, moved as double bit patterns
+        template<>
+        struct lanes<8> {
+            using vec = __m128d;
+            static constexpr std::size_t width = 2;
+
+            static vec load(const void* p) noexcept { return _mm_loadu_pd(static_cast<const double*>(p)); }
+            static void store(void* p, vec v) noexcept { _mm_storeu_pd(static_cast<double*>(p), v); }
+
+            template<std::size_t K>
+            static void split(const void* p, vec (&v)[K]) noexcept {
+                const double* x = static_cast<const double*>(p);
+                if constexpr (K == 1) {
+                    v[0] = _mm_loadu_pd(x);
+                } else if constexpr (K == 2) {
+                    vec p0 = _mm_loadu_pd(x), p1 = _mm_loadu_pd(x + 2);
+                    v[0] = _mm_unpacklo_pd(p0, p1);
+                    v[1] = _mm_unpackhi_pd(p0, p1);
+                } else if constexpr (K == 3) {
+                    vec p0 = _mm_loadu_pd(x), p1 = _mm_loadu_pd(x + 2), p2 = _mm_loadu_pd(x + 4);
+                    v[0] = _mm_shuffle_pd(p0, p1, 2);
+                    v[1] = _mm_shuffle_pd(p0, p2, 1);
+                    v[2] = _mm_shuffle_pd(p1, p2, 2);
+                } else {
+                    vec p0 = _mm_loadu_pd(x), p1 = _mm_loadu_pd(x + 2), p2 = _mm_loadu_pd(x + 4), p3 = _mm_loadu_pd(x + 6);
+                    v[0] = _mm_unpacklo_pd(p0, p2);
+                    v[1] = _mm_unpackhi_pd(p0, p2);
+                    v[2] = _mm_unpacklo_pd(p1, p3);
+                    v[3] = _mm_unpackhi_pd(p1, p3);
+                }
+            }
+
+            template<std::size_t K>
+            static void merge(const vec (&v)[K], void* p) noexcept {
+                double* z = static_cast<double*>(p);
+                if constexpr (K == 1) {
+                    _mm_storeu_pd(z, v[0]);
+                } else if constexpr (K == 2) {
+                    _mm_storeu_pd(z, _mm_unpacklo_pd(v[0], v[1]));
+                    _mm_storeu_pd(z + 2, _mm_unpackhi_pd(v[0], v[1]));
+                } else if constexpr (K == 3) {
+                    _mm_storeu_pd(z, _mm_unpacklo_pd(v[0], v[1]));
+                    _mm_storeu_pd(z + 2, _mm_shuffle_pd(v[2], v[0], 2));
+                    _mm_storeu_pd(z + 4, _mm_unpackhi_pd(v[1], v[2]));
+                } else {
+                    _mm_storeu_pd(z, _mm_unpacklo_pd(v[0], v[1]));
+                    _mm_storeu_pd(z + 2, _mm_unpacklo_pd(v[2], v[3]));
+                    _mm_storeu_pd(z + 4, _mm_unpackhi_pd(v[0], v[1]));
+                    _mm_storeu_pd(z + 6, _mm_unpackhi_pd(v[2], v[3]));
+                }
+            }
+        };
+
+        template<std::size_t Bytes>
+        inline constexpr bool has_lanes = Bytes == 4 || Bytes == 8;
+#elif defined(DMOPEX_SIMD_NEON)
+        template<std::size_t Bytes>
+        struct lanes;
+
+        // The structure loads and stores deinterleave and interleave the leaves directly
+        template<>
+        struct lanes<4> {
+            using vec = uint32x4_t;
+            static constexpr std::size_t width = 4;
+
+            static vec load(const void* p) noexcept { return vld1q_u32(static_cast<const std::uint32_t*>(p)); }
+            static void store(void* p, vec v) noexcept { vst1q_u32(static_cast<std::uint32_t*>(p), v); }
+
+            template<std::size_t K>
+            static void split(const void* p, vec (&v)[K]) noexcept {
+                const std::uint32_t* x = static_cast<const std::uint32_t*>(p);
+                if constexpr (K == 1) {
+                    v[0] = vld1q_u32(x);
+                } else if constexpr (K == 2) {
+                    uint32x4x2_t r = vld2q_u32(x);
+                    v[0] = r.val[0], v[1] = r.val[1];
+                } else if constexpr (K == 3) {
+                    uint32x4x3_t r = vld3q_u32(x);
+                    v[0] = r.val[0], v[1] = r.val[1], v[2] = r.val[2];
+                } else {
+                    uint32x4x4_t r = vld4q_u32(x);
+                    v[0] = r.val[0], v[1] = r.val[1], v[2] = r.val[2], v[3] = r.val[3];
+                }
+            }
+
+            template<std::size_t K>
+            static void merge(const vec (&v)[K], void* p) noexcept {
+                std::uint32_t* z = static_cast<std::uint32_t*>(p);
+                if constexpr (K == 1) {
+                    vst1q_u32(z, v[0]);
+                } else if constexpr (K == 2) {
+                    vst2q_u32(z, (uint32x4x2_t{ { v[0], v[1] } }));
+                } else if constexpr (K == 3) {
+                    vst3q_u32(z, (uint32x4x3_t{ { v[0], v[1], v[2] } }));
+                } else {
+                    vst4q_u32(z, (uint32x4x4_t{ { v[0], v[1], v[2], v[3] } }));
+                }
+            }
+        };
+
+        template<std::size_t Bytes>
+        inline constexpr bool has_lanes = Bytes == 4;
+#endif
+
+        template<typename T, typename Cols, typename... Path, std::size_t... I>
+        void scatter_leaves(const T* in, const Cols& out, std::size_t from, std::size_t n, std::tuple<Path...>*, std::index_sequence<I...>) {
+            copy_leaf copy;
+            for (std::size_t i = from; i < n; ++i) {
+                (fields_detail::zip(copy, std::get<I>(out)[i], Path::get(in[i])), ...);
+            }
+        }
+
+        template<typename T, typename Cols, typename... Path, std::size_t... I>
+        void gather_leaves(const Cols& in, T* out, std::size_t from, std::size_t n, std::tuple<Path...>*, std::index_sequence<I...>) {
+            copy_leaf copy;
+            for (std::size_t i = from; i < n; ++i) {
+                (fields_detail::zip(copy, Path::get(out[i]), std::get<I>(in)[i]), ...);
+            }
+        }
+
+        template<typename T>
+        void scatter(const T* in, const columns_t<T>& out, std::size_t n) {
+            std::size_t i = 0;
+#if defined(DMOPEX_SIMD_SSE2) || defined(DMOPEX_SIMD_NEON)
+            constexpr std::size_t K = interleaved<T>::leaves;
+            if constexpr (K != 0) {
+                using L = typename interleaved<T>::leaf_type;
+                if constexpr (has_lanes<sizeof(L)>) {
+                    using V = lanes<sizeof(L)>;
+                    const L* x = reinterpret_cast<const L*>(in);
+                    if (n >= V::width && interleaved<T>::in_memory_order(in[0])) {
+                        std::apply([&](auto*... column) {
+                            L* const z[K] = { column... };
+                            typename V::vec v[K];
+                            for (; i + V::width <= n; i += V::width) {
+                                V::template split<K>(x + i * K, v);
+                                for (std::size_t k = 0; k < K; ++k) {
+                                    V::store(z[k] + i, v[k]);
+                                }
+                            }
+                        }, out);
+                    }
+                }
+            }
+#endif
+            transpose_detail::scatter_leaves(in, out, i, n, static_cast<leaf_fields_t<T>*>(nullptr),
+                std::make_index_sequence<leaf_count_v<T>>{});
+        }
+
+        template<typename T>
+        void gather(const const_columns_t<T>& in, T* out, std::size_t n) {
+            std::size_t i = 0;
+#if defined(DMOPEX_SIMD_SSE2) || defined(DMOPEX_SIMD_NEON)
+            constexpr std::size_t K = interleaved<T>::leaves;
+            if constexpr (K != 0) {
+                using L = typename interleaved<T>::leaf_type;
+                if constexpr (has_lanes<sizeof(L)>) {
+                    using V = lanes<sizeof(L)>;
+                    L* z = reinterpret_cast<L*>(out);
+                    if (n >= V::width && interleaved<T>::in_memory_order(out[0])) {
+                        std::apply([&](const auto*... column) {
+                            const L* const x[K] = { column... };
+                            typename V::vec v[K];
+                            for (; i + V::width <= n; i += V::width) {
+                                for (std::size_t k = 0; k < K; ++k) {
+                                    v[k] = V::load(x[k] + i);
+                                }
+                                V::template merge<K>(v, z + i * K);
+                            }
+                        }, in);
+                    }
+                }
+            }
+#endif
+            transpose_detail::gather_leaves(in, out, i, n, static_cast<leaf_fields_t<T>*>(nullptr),
+                std::make_index_sequence<leaf_count_v<T>>{});
+        }
+    } // namespace transpose_detail
+
+    // columns[k][i] = k-th leaf of in[i] for i < in.size()
+    template<typename T>
+    void aos_to_soa(span<const T> in, const columns_t<T>& out) {
+        static_assert(is_reflected_v<T>, "dmopex::aos_to_soa needs a reflected struct");
+        transpose_detail::scatter(in.data(), out, in.size());
+    }
+
+    // k-th leaf of out[i] = columns[k][i] for i < out.size(), members not reflected are left as they are
+    template<typename T>
+    void soa_to_aos(const const_columns_t<T>& in, span<T> out) {
+        static_assert(is_reflected_v<T>, "dmopex::soa_to_aos needs a reflected struct");
+        transpose_detail::gather(in, out.data(), out.size());
+    }
+} // namespace dmopex
+
+#endif // __DMOPEX_TRANSPOSE_H_INCLUDE__
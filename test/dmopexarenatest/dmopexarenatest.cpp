@@ -0,0 +1,144 @@
+﻿#include "dmopex.h"
+#include "dmopex_arena.h"
+#include "gtest.h"
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#   include <malloc.h>
+#endif
+
+// 统计本进程的 operator new 调用次数
+static std::atomic<std::size_t> g_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++g_allocations;
+    const std::size_t a = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+    if (void* p = _aligned_malloc(size == 0 ? 1 : size, a)) {
+#else
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+#endif
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#if defined(_WIN32)
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 对齐要求超过缓存行的类型
+struct alignas(256) Big {
+    float values[4];
+};
+
+TEST(ArenaTest, Allocate) {
+    dmopex::arena scratch(1024);
+    dmopex::span<Vector3D> points = scratch.allocate<Vector3D>(10);
+    dmopex::span<std::uint8_t> bytes = scratch.allocate<std::uint8_t>(3);
+    dmopex::span<double> values = scratch.allocate<double>(4);
+    EXPECT_EQ(points.size(), 10u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(points.data()) % dmopex::arena::alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bytes.data()) % dmopex::arena::alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % dmopex::arena::alignment, 0u);
+    // 120 字节的点, 3 字节, 4 个 double, 每个数组从缓存行开始
+    EXPECT_EQ(scratch.used(), 192u + 32u);
+
+    // 对齐超过 64 字节时按地址对齐, 块本身只按缓存行对齐
+    for (int round = 0; round < 50; ++round) {
+        dmopex::arena aligned(4096);
+        aligned.allocate<char>(1);
+        dmopex::span<Big> big = aligned.allocate<Big>(1);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big.data()) % alignof(Big), 0u);
+        aligned.allocate<char>(1);
+        big = aligned.allocate<Big>(20);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big.data()) % alignof(Big), 0u);
+    }
+
+    // 超出当前块时串接新块, reset 后合并为一块
+    dmopex::span<Vector3D> large = scratch.allocate<Vector3D>(1000);
+    large[999] = Vector3D{ 1, 2, 3 };
+    EXPECT_EQ(scratch.block_count(), 2u);
+    const std::size_t capacity = scratch.capacity();
+    scratch.reset();
+    EXPECT_EQ(scratch.used(), 0u);
+    EXPECT_EQ(scratch.block_count(), 1u);
+    EXPECT_EQ(scratch.capacity(), capacity);
+
+    // scope 结束时回退
+    scratch.allocate<float>(1);
+    const std::size_t before = scratch.used();
+    {
+        dmopex::arena::scope temporaries(scratch);
+        scratch.allocate<float>(500);
+        EXPECT_GT(scratch.used(), before);
+    }
+    EXPECT_EQ(scratch.used(), before);
+}
+
+TEST(ArenaTest, ThreadLocal) {
+    dmopex::arena* main_arena = &dmopex::arena::local();
+    EXPECT_EQ(&dmopex::arena::local(), main_arena);
+    dmopex::arena* other = nullptr;
+    std::thread([&] { other = &dmopex::arena::local(); }).join();
+    EXPECT_NE(other, main_arena);
+}
+
+TEST(ArenaTest, SteadyStateFrames) {
+    const std::size_t n = 1000;
+    std::vector<Vector3D> positions(n), velocities(n), scales(n, Vector3D{ 2, 2, 2 }), offsets(n, Vector3D{ 1, 1, 1 });
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        positions[i] = Vector3D{ f, -f, 0.5f * f };
+        velocities[i] = Vector3D{ 1, 2, 3 };
+    }
+
+    // 初始容量很小, 前几帧需要扩容
+    dmopex::arena scratch(256);
+    auto frame = [&] {
+        dmopex::span<Vector3D> moved = dmopex::batch_add<Vector3D>(scratch, positions, velocities);
+        dmopex::span<Vector3D> scaled = dmopex::batch_mul<Vector3D>(scratch, moved, scales);
+        dmopex::span<Vector3D> result = dmopex::batch_sub<Vector3D>(scratch, scaled, offsets);
+        Vector3D last = result[n - 1];
+        scratch.reset();
+        return last;
+    };
+
+    const std::size_t warm_up_start = g_allocations;
+    frame();
+    EXPECT_GT(g_allocations - warm_up_start, 0u);
+
+    const std::size_t steady_start = g_allocations;
+    Vector3D last{};
+    for (int i = 0; i < 100; ++i) {
+        last = frame();
+    }
+    EXPECT_EQ(g_allocations - steady_start, 0u);
+    EXPECT_TRUE(last == (Vector3D{ 1999, -1995, 1004 }));
+}
@@ -0,0 +1,163 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_batch.h"
+#include "dmopex_format.h"
+#include "dmopex_parse.h"
+#include "dmopex_hash.h"
+#include "dmopex_project.h"
+#include "gtest.h"
+
+#include <array>
+#include <vector>
+#include <sstream>
+#include <cstdint>
+#include <stdexcept>
+
+// 动画关键帧: C 数组权重 + std::array 矩阵, 全部为 float, 可按扁平数组批量处理
+struct Pose {
+    float weights[8];
+    std::array<float, 16> matrix;
+
+    DEFINE_STRUCT_OPERATORS(Pose, weights, matrix)
+};
+
+// 成员类型不同, 逐成员处理
+struct Track {
+    int frame;
+    float weights[4];
+
+    DEFINE_STRUCT_OPERATORS(Track, frame, weights)
+};
+
+// 非侵入式, 饱和策略
+struct Mix {
+    std::uint8_t levels[3];
+    std::array<int, 2> offsets;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE_EX(Mix, dmopex::saturate_policy, levels, offsets)
+
+struct Limits {
+    std::array<int, 2> v;
+
+    DEFINE_STRUCT_OPERATORS_EX(Limits, dmopex::checked_policy, v)
+};
+
+static Pose make_pose(float base) {
+    Pose p{};
+    for (int k = 0; k < 8; ++k) {
+        p.weights[k] = base + static_cast<float>(k);
+    }
+    for (int k = 0; k < 16; ++k) {
+        p.matrix[k] = base * static_cast<float>(k);
+    }
+    return p;
+}
+
+TEST(ArrayTest, ElementWiseArithmetic) {
+    Pose a = make_pose(1.0f);
+    Pose b = make_pose(2.0f);
+    Pose sum = a + b;
+    for (int k = 0; k < 8; ++k) {
+        EXPECT_FLOAT_EQ(sum.weights[k], a.weights[k] + b.weights[k]);
+    }
+    for (int k = 0; k < 16; ++k) {
+        EXPECT_FLOAT_EQ(sum.matrix[k], a.matrix[k] + b.matrix[k]);
+    }
+
+    sum -= b;
+    EXPECT_TRUE(sum == a);
+    EXPECT_TRUE(sum != b);
+
+    Track t{ 3, { 1.0f, 2.0f, 3.0f, 4.0f } };
+    Track scaled = t * Track{ 2, { 0.5f, 0.5f, 2.0f, 2.0f } };
+    EXPECT_EQ(scaled.frame, 6);
+    EXPECT_FLOAT_EQ(scaled.weights[0], 0.5f);
+    EXPECT_FLOAT_EQ(scaled.weights[3], 8.0f);
+}
+
+TEST(ArrayTest, PolicyAppliesToElements) {
+    Mix a{ { 200, 10, 0 }, { 1, 2 } };
+    Mix b{ { 100, 10, 5 }, { 3, 4 } };
+    Mix sum = a + b;
+    EXPECT_EQ(sum.levels[0], 255);
+    EXPECT_EQ(sum.levels[1], 20);
+    EXPECT_EQ(sum.levels[2], 5);
+    EXPECT_EQ(sum.offsets[1], 6);
+
+    Mix diff = b - a;
+    EXPECT_EQ(diff.levels[0], 0);
+    EXPECT_EQ(diff.levels[2], 5);
+    EXPECT_TRUE(a == (Mix{ { 200, 10, 0 }, { 1, 2 } }));
+
+    Limits big{ { 1, 2147483647 } };
+    EXPECT_THROW(big + (Limits{ { 1, 1 } }), std::overflow_error);
+}
+
+TEST(ArrayTest, PrintFormatParseAndHash) {
+    Track t{ 3, { 1.5f, 2.0f, 3.0f, 4.0f } };
+    std::ostringstream os;
+    os << t;
+    EXPECT_EQ(os.str(), "(3, [1.5, 2, 3, 4])");
+    EXPECT_EQ(dmopex::to_string(t), "(3, [1.5, 2, 3, 4])");
+
+    Track back{};
+    ASSERT_TRUE(static_cast<bool>(dmopex::parse("(3, [1.5, 2, 3, 4])", back)));
+    EXPECT_TRUE(back == t);
+    EXPECT_FALSE(static_cast<bool>(dmopex::parse("(3, [1.5, 2, 3])", back)));
+    EXPECT_FALSE(static_cast<bool>(dmopex::parse("(3, [1.5, 2, 3, 4, 5])", back)));
+
+    Mix m{ { 1, 2, 3 }, { -4, 5 } };
+    Mix m_back{};
+    ASSERT_TRUE(static_cast<bool>(dmopex::parse(dmopex::to_string(m), m_back)));
+    EXPECT_TRUE(m_back == m);
+
+    Track other = t;
+    EXPECT_EQ(dmopex::hash(t), dmopex::hash(other));
+    other.weights[2] = 0.0f;
+    EXPECT_NE(dmopex::hash(t), dmopex::hash(other));
+}
+
+TEST(ArrayTest, ProjectionOfArrayMembers) {
+    Track a{ 1, { 1.0f, 2.0f, 3.0f, 4.0f } };
+    Track b{ 9, { 1.0f, 1.0f, 1.0f, 1.0f } };
+    dmopex::project<&Track::weights>(a) += b;
+    EXPECT_EQ(a.frame, 1);
+    EXPECT_FLOAT_EQ(a.weights[3], 5.0f);
+
+    b.weights[3] = 5.0f;
+    EXPECT_TRUE(dmopex::project<&Track::weights>(b) < dmopex::project<&Track::weights>(a));
+    EXPECT_FALSE(dmopex::project<&Track::weights>(a) < dmopex::project<&Track::weights>(b));
+    EXPECT_FALSE(dmopex::project<&Track::weights>(a) == dmopex::project<&Track::weights>(b));
+}
+
+template<typename T, typename Make>
+static void expect_batch_matches_scalar(Make make) {
+    for (std::size_t n : { 0u, 1u, 5u, 33u }) {
+        std::vector<T> a, b, out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a.push_back(make(static_cast<int>(i)));
+            b.push_back(make(static_cast<int>(i) + 3));
+        }
+        dmopex::batch_add<T>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == a[i] + b[i]);
+        }
+        dmopex::batch_mul<T>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == a[i] * b[i]);
+        }
+    }
+}
+
+TEST(ArrayTest, BatchMatchesScalar) {
+    static_assert(dmopex::batch_detail::flat_layout<Pose>::value, "Pose is a flat float array");
+    static_assert(!dmopex::batch_detail::flat_layout<Track>::value, "Track mixes int and float");
+
+    expect_batch_matches_scalar<Pose>([](int i) { return make_pose(static_cast<float>(i)); });
+    expect_batch_matches_scalar<Track>([](int i) {
+        return Track{ i, { 1.0f * i, 2.0f * i, 3.0f, 4.0f } };
+    });
+    expect_batch_matches_scalar<Mix>([](int i) {
+        return Mix{ { static_cast<std::uint8_t>(i * 40), 7, 9 }, { i, -i } };
+    });
+}
@@ -0,0 +1,126 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_atomic.h"
+#include "dmopex_color.h"
+#include "gtest.h"
+
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <stdexcept>
+
+// 16 字节, 整体双字 CAS
+struct Point2D {
+    double x, y;
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+// 8 字节, 溢出检查策略
+struct Budget {
+    std::int32_t gold, gems;
+
+    DEFINE_STRUCT_OPERATORS_EX(Budget, dmopex::checked_policy, gold, gems)
+};
+
+// 大于 16 字节, 逐成员原子
+struct SessionStats {
+    std::int64_t bytes_in, bytes_out;
+    std::int32_t requests, errors;
+    double latency_ms;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(SessionStats, bytes_in, bytes_out, requests, errors, latency_ms)
+
+// 嵌套成员与饱和策略, 逐成员原子
+struct Meter {
+    Point2D peak;
+    std::uint8_t level;
+    std::uint16_t hits;
+
+    DEFINE_STRUCT_OPERATORS_EX(Meter, dmopex::saturate_policy, peak, level, hits)
+};
+
+template<typename F>
+static void run_threads(int count, F f) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < count; ++t) {
+        threads.emplace_back(f);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(AtomicTest, StorageSelection) {
+    EXPECT_TRUE(dmopex::atomic<dmopex::rgba8>::whole_struct);
+    EXPECT_TRUE(dmopex::atomic<Budget>::whole_struct);
+#if defined(DMOPEX_ATOMIC_DWCAS)
+    EXPECT_TRUE(dmopex::atomic<Point2D>::whole_struct);
+#endif
+    EXPECT_FALSE(dmopex::atomic<SessionStats>::whole_struct);
+    EXPECT_FALSE(dmopex::atomic<Meter>::whole_struct);
+
+    dmopex::atomic<Point2D> p;
+    EXPECT_TRUE(p.is_lock_free());
+    dmopex::atomic<SessionStats> s;
+    EXPECT_TRUE(s.is_lock_free());
+}
+
+TEST(AtomicTest, LoadStoreExchange) {
+    dmopex::atomic<Point2D> p(Point2D{ 1.0, 2.0 });
+    EXPECT_TRUE(p.load() == (Point2D{ 1.0, 2.0 }));
+
+    p.store(Point2D{ 3.0, 4.0 });
+    Point2D previous = p.exchange(Point2D{ 5.0, 6.0 });
+    EXPECT_TRUE(previous == (Point2D{ 3.0, 4.0 }));
+    EXPECT_TRUE(static_cast<Point2D>(p) == (Point2D{ 5.0, 6.0 }));
+
+    dmopex::atomic<SessionStats> s;
+    s = SessionStats{ 1, 2, 3, 4, 0.5 };
+    SessionStats old = s.exchange(SessionStats{ 10, 20, 30, 40, 5.0 });
+    EXPECT_TRUE(old == (SessionStats{ 1, 2, 3, 4, 0.5 }));
+    EXPECT_TRUE(s.load() == (SessionStats{ 10, 20, 30, 40, 5.0 }));
+
+    Point2D sum = (p += Point2D{ 1.0, 1.0 });
+    EXPECT_TRUE(sum == (Point2D{ 6.0, 7.0 }));
+    EXPECT_TRUE(p.fetch_sub(Point2D{ 6.0, 7.0 }) == (Point2D{ 6.0, 7.0 }));
+    EXPECT_TRUE(p.load() == (Point2D{ 0.0, 0.0 }));
+}
+
+TEST(AtomicTest, ConcurrentUpdatesAreExact) {
+    const int threads = 8;
+    const int rounds = 20000;
+
+    dmopex::atomic<Point2D> p;
+    dmopex::atomic<dmopex::rgba8> c;
+    dmopex::atomic<SessionStats> s;
+    run_threads(threads, [&] {
+        for (int i = 0; i < rounds; ++i) {
+            p += Point2D{ 1.0, 0.5 };
+            c += dmopex::rgba8{ 1, 0, 0, 0 };
+            s += SessionStats{ 100, 50, 1, i % 2, 0.25 };
+            s -= SessionStats{ 0, 25, 0, 0, 0.0 };
+        }
+    });
+
+    EXPECT_TRUE(p.load() == (Point2D{ threads * rounds * 1.0, threads * rounds * 0.5 }));
+    EXPECT_EQ(c.load().r, 255);
+    EXPECT_TRUE(s.load() == (SessionStats{ 100LL * threads * rounds, 25LL * threads * rounds, threads * rounds, threads * rounds / 2, threads * rounds * 0.25 }));
+}
+
+TEST(AtomicTest, PoliciesApplyPerMember) {
+    dmopex::atomic<Meter> m;
+    run_threads(4, [&] {
+        for (int i = 0; i < 1000; ++i) {
+            m += Meter{ { 1.0, 2.0 }, 1, 100 };
+        }
+    });
+    Meter total = m.load();
+    EXPECT_TRUE(total.peak == (Point2D{ 4000.0, 8000.0 }));
+    EXPECT_EQ(total.level, 255);
+    EXPECT_EQ(total.hits, 65535);
+
+    dmopex::atomic<Budget> b(Budget{ 2147483600, 0 });
+    EXPECT_THROW(b += (Budget{ 100, 1 }), std::overflow_error);
+    EXPECT_TRUE(b.load() == (Budget{ 2147483600, 0 }));
+}
@@ -0,0 +1,139 @@
+﻿#include "dmopex.h"
+#include "dmopex_column.h"
+#include "gtest.h"
+
+#include <vector>
+#include <numeric>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 列按 32 字节步长访问
+struct Particle {
+    Vector3D position;
+    float mass;
+    int id;
+    float speed[3];
+
+    DEFINE_STRUCT_OPERATORS(Particle, position, mass, id, speed)
+};
+
+// 饱和策略, 列运算沿用
+struct Pixel {
+    std::uint8_t r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS_EX(Pixel, dmopex::saturate_policy, r, g, b, a)
+};
+
+std::vector<Particle> make_particles(std::size_t n) {
+    std::vector<Particle> particles(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        particles[i] = Particle{ { f, -f, 2.0f * f }, 1.0f + f, static_cast<int>(i), { f, 0.5f, -1.0f } };
+    }
+    return particles;
+}
+
+// 临时容器在视图使用前已销毁, column 不接受
+template<typename Range, typename = void>
+struct has_column : std::false_type {};
+
+template<typename Range>
+struct has_column<Range, std::void_t<decltype(dmopex::column<&Particle::mass>(std::declval<Range>()))>> : std::true_type {};
+
+static_assert(has_column<std::vector<Particle>&>::value && has_column<const std::vector<Particle>&>::value, "arrays that outlive the view");
+static_assert(has_column<dmopex::span<Particle>>::value && has_column<Particle (&)[4]>::value, "views and C arrays");
+static_assert(!has_column<std::vector<Particle>>::value && !has_column<const std::vector<Particle>>::value, "temporary containers");
+
+TEST(ColumnTest, View) {
+    std::vector<Particle> particles = make_particles(19);
+    auto mass = dmopex::column<&Particle::mass>(particles);
+    static_assert(std::is_same_v<decltype(mass)::element_type, float>, "mutable view over a mutable array");
+    EXPECT_EQ(mass.size(), 19u);
+    EXPECT_EQ(mass.stride(), static_cast<std::ptrdiff_t>(sizeof(Particle)));
+    EXPECT_EQ(mass[4], 5.0f);
+    EXPECT_EQ(&mass[4], &particles[4].mass);
+
+    mass[0] = 100.0f;
+    EXPECT_EQ(particles[0].mass, 100.0f);
+    EXPECT_EQ(std::accumulate(mass.begin() + 1, mass.end(), 0.0f), 189.0f);
+    EXPECT_EQ(mass.end() - mass.begin(), 19);
+    EXPECT_EQ(mass.subspan(10, 2)[1], 12.0f);
+
+    // 只对该成员排序, 其他成员不动
+    std::sort(mass.begin(), mass.end(), [](float a, float b) { return b < a; });
+    EXPECT_EQ(particles[0].mass, 100.0f);
+    EXPECT_EQ(particles[1].mass, 19.0f);
+    EXPECT_EQ(particles[18].mass, 2.0f);
+    EXPECT_EQ(particles[18].id, 18);
+
+    const std::vector<Particle>& readonly = particles;
+    auto ids = dmopex::column<&Particle::id>(readonly);
+    static_assert(std::is_same_v<decltype(ids)::element_type, const int>, "read-only view over a const array");
+    EXPECT_EQ(*std::max_element(ids.begin(), ids.end()), 18);
+
+    std::vector<float> contiguous{ 3.0f, 1.0f, 2.0f };
+    dmopex::column_view<const float> values(contiguous);
+    EXPECT_EQ(values.stride(), static_cast<std::ptrdiff_t>(sizeof(float)));
+    EXPECT_EQ(dmopex::min_of(values), 1.0f);
+
+    std::vector<Particle> none;
+    EXPECT_TRUE(dmopex::column<&Particle::mass>(none).empty());
+}
+
+TEST(ColumnTest, BatchArithmetic) {
+    std::vector<Particle> particles = make_particles(19);
+    std::vector<Particle> before = particles;
+    auto mass = dmopex::column<&Particle::mass>(particles);
+    auto x = dmopex::column<&Particle::position>(particles);
+    dmopex::batch_mul(mass, mass, mass);
+    dmopex::batch_add(x, x, x);
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        EXPECT_EQ(particles[i].mass, before[i].mass * before[i].mass);
+        EXPECT_TRUE(particles[i].position == before[i].position + before[i].position);
+        EXPECT_EQ(particles[i].id, before[i].id);
+        EXPECT_EQ(particles[i].speed[0], before[i].speed[0]);
+    }
+
+    // 输出可以是另一个数组的列
+    std::vector<Particle> out(particles.size());
+    const std::vector<Particle>& readonly = before;
+    dmopex::batch_sub(dmopex::column<&Particle::mass>(readonly), dmopex::column<&Particle::mass>(readonly),
+        dmopex::column<&Particle::mass>(out));
+    EXPECT_EQ(out[7].mass, 0.0f);
+
+    std::vector<Pixel> pixels(9, Pixel{ 200, 10, 0, 255 });
+    auto red = dmopex::column<&Pixel::r>(pixels);
+    dmopex::batch_add(red, red, red);
+    EXPECT_EQ(pixels[8].r, 255);
+    EXPECT_EQ(pixels[8].g, 10);
+}
+
+TEST(ColumnTest, Reductions) {
+    std::vector<Particle> particles = make_particles(19);
+    auto mass = dmopex::column<&Particle::mass>(particles);
+    EXPECT_EQ(dmopex::sum_of(mass), 190.0f);
+    EXPECT_EQ(dmopex::sum_of(dmopex::column<&Particle::id>(particles)), 171);
+    EXPECT_EQ(dmopex::dot(mass, mass), 2470.0f);
+    EXPECT_EQ(dmopex::min_of(mass), 1.0f);
+    EXPECT_EQ(dmopex::max_of(mass), 19.0f);
+
+    dmopex::aabb<float> range = dmopex::bounds(mass.subspan(3, 5));
+    EXPECT_EQ(range.lo, 4.0f);
+    EXPECT_EQ(range.hi, 8.0f);
+
+    // 成员本身是结构体或数组时逐叶子
+    dmopex::aabb<Vector3D> box = dmopex::bounds(dmopex::column<&Particle::position>(particles));
+    EXPECT_TRUE(box.lo == (Vector3D{ 0.0f, -18.0f, 0.0f }));
+    EXPECT_TRUE(box.hi == (Vector3D{ 18.0f, 0.0f, 36.0f }));
+
+    std::vector<Pixel> pixels{ { 1, 2, 3, 4 }, { 250, 250, 250, 250 } };
+    static_assert(std::is_same_v<decltype(dmopex::sum_of(dmopex::column<&Pixel::r>(pixels))), int>, "small integers are summed as int");
+    EXPECT_EQ(dmopex::sum_of(dmopex::column<&Pixel::r>(pixels)), 251);
+}
@@ -0,0 +1,188 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_format.h"
+#include "dmopex_color.h"
+#include "gtest.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+struct Point2D {
+    double x, y;
+
+    Point2D() = default;
+    Point2D(double x_, double y_) : x(x_), y(y_) {}
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+struct Vector3D {
+    double x, y, z;
+
+    Vector3D() = default;
+    Vector3D(double x_, double y_, double z_) : x(x_), y(y_), z(z_) {}
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 非侵入式结构体
+struct Color {
+    int r, g, b, a;
+
+    Color() = default;
+    Color(int r_, int g_, int b_, int a_ = 255) : r(r_), g(g_), b(b_), a(a_) {}
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Color, r, g, b, a)
+
+// 成员本身也是反射结构体
+struct Sprite {
+    Vector3D pos;
+    Color tint;
+    unsigned id;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Sprite, pos, tint, id)
+
+// dmostream.h 的 ostream formatter 通过 is_streamable 探测 operator<<,dmopex_format.h 对探测用的
+// test_stream 删除了反射结构体的 operator<<,否则两个 formatter 特化冲突。dmformat 更新后若探测方式
+// 改变,这里编译失败
+static_assert(!fmt::internal::is_streamable<Point2D, char>::value, "dmostream.h must not see operator<< of reflected structs");
+static_assert(!fmt::internal::is_streamable<Color, char>::value, "dmostream.h must not see operator<< of reflected structs");
+static_assert(!fmt::internal::is_streamable<Sprite, char>::value, "dmostream.h must not see operator<< of reflected structs");
+static_assert(fmt::internal::is_streamable<std::string_view, char>::value, "other streamable types keep the ostream formatter");
+
+template<typename T>
+std::string stream_text(const T& obj) {
+    std::ostringstream oss;
+    oss << obj;
+    return oss.str();
+}
+
+// 与 operator<< 输出一致
+TEST(DmOpExFormatTest, MatchesStreamOutput) {
+    Point2D p{ 1.5, 2.5 };
+    Vector3D v{ 1.0 / 3, -2.0, 1e20 };
+    Color c{ 255, 0, 0 };
+
+    EXPECT_EQ(fmt::format("{}", p), stream_text(p));
+    EXPECT_EQ(fmt::format("{}", v), stream_text(v));
+    EXPECT_EQ(fmt::format("{}", c), stream_text(c));
+    EXPECT_EQ(fmt::format("{}", p), "(1.5, 2.5)");
+    EXPECT_EQ(dmopex::to_string(c), "(255, 0, 0, 255)");
+}
+
+// 8 位整数成员按数字输出, 两种方式一致
+TEST(DmOpExFormatTest, ByteMembers) {
+    dmopex::rgba8 c{ 65, 66, 67, 68 };
+    EXPECT_EQ(fmt::format("{}", c), stream_text(c));
+    EXPECT_EQ(stream_text(c), "(65, 66, 67, 68)");
+}
+
+// 带字段名输出
+TEST(DmOpExFormatTest, NamedFields) {
+    Point2D p{ 1.5, 2.5 };
+    EXPECT_EQ(fmt::format("{:n}", p), "(x: 1.5, y: 2.5)");
+    EXPECT_EQ(dmopex::to_string(Color{ 1, 2, 3, 4 }, true), "(r: 1, g: 2, b: 3, a: 4)");
+}
+
+// 嵌套结构体
+TEST(DmOpExFormatTest, NestedStruct) {
+    Sprite s{ Vector3D{ 1.0, 2.0, 3.0 }, Color{ 10, 20, 30 }, 7u };
+    EXPECT_EQ(fmt::format("{}", s), "((1, 2, 3), (10, 20, 30, 255), 7)");
+    EXPECT_EQ(fmt::format("{:n}", s), "(pos: (x: 1, y: 2, z: 3), tint: (r: 10, g: 20, b: 30, a: 255), id: 7)");
+}
+
+// 直接写入 memory_buffer
+TEST(DmOpExFormatTest, AppendToBuffer) {
+    fmt::memory_buffer buf;
+    dmopex::format_to(buf, Point2D{ 1.0, 2.0 });
+    fmt::format_to(buf, " | {} | ", 42);
+    dmopex::format_to(buf, Color{ 1, 2, 3 });
+    EXPECT_EQ(fmt::to_string(buf), "(1, 2) | 42 | (1, 2, 3, 255)");
+}
+
+// 批量输出: 多线程分块结果与顺序输出一致
+TEST(DmOpExFormatTest, FormatRange) {
+    std::vector<Vector3D> positions;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        positions.emplace_back(i * 0.5, -i, i / 3.0);
+        expected += stream_text(positions.back()) + "\n";
+    }
+
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        dmopex::format_range_options options;
+        options.threads = threads;
+        options.chunk_size = 37;
+
+        std::string text;
+        std::size_t calls = 0;
+        dmopex::format_range(dmopex::span<const Vector3D>(positions), [&](const char* data, std::size_t size) {
+            text.append(data, size);
+            ++calls;
+        }, options);
+
+        EXPECT_EQ(text, expected);
+        EXPECT_EQ(calls, (positions.size() + 36) / 37);
+    }
+}
+
+// 转换为文本时可能抛出异常的成员
+struct Fuse {
+    int n;
+
+    operator std::string_view() const {
+        if (n < 0) {
+            throw std::runtime_error("fuse");
+        }
+        return "ok";
+    }
+};
+
+struct Charge {
+    Fuse fuse;
+
+    DEFINE_STRUCT_FIELDS(Charge, fuse)
+};
+
+// 工作线程或 sink 抛出的异常在调用线程重新抛出
+TEST(DmOpExFormatTest, FormatRangeException) {
+    std::vector<Charge> charges(1000, Charge{ { 1 } });
+    charges[500].fuse.n = -1;
+
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        dmopex::format_range_options options;
+        options.threads = threads;
+        options.chunk_size = 37;
+
+        std::size_t written = 0;
+        EXPECT_THROW(dmopex::format_range(charges, [&](const char*, std::size_t size) { written += size; }, options),
+            std::runtime_error);
+        EXPECT_LT(written, charges.size() * 5);
+
+        charges[500].fuse.n = 1;
+        std::size_t calls = 0;
+        EXPECT_THROW(dmopex::format_range(charges, [&](const char*, std::size_t) {
+            if (++calls == 3) {
+                throw std::length_error("sink");
+            }
+        }, options), std::length_error);
+        charges[500].fuse.n = -1;
+    }
+}
+
+TEST(DmOpExFormatTest, FormatRangeNamed) {
+    std::vector<Color> colors{ Color{ 1, 2, 3 }, Color{ 4, 5, 6, 7 } };
+    dmopex::format_range_options options;
+    options.named = true;
+    options.separator = ';';
+
+    std::string text;
+    dmopex::format_range(colors, [&](const char* data, std::size_t size) { text.append(data, size); }, options);
+    EXPECT_EQ(text, "(r: 1, g: 2, b: 3, a: 255);(r: 4, g: 5, b: 6, a: 7);");
+
+    text.clear();
+    dmopex::format_range(std::vector<Color>{}, [&](const char* data, std::size_t size) { text.append(data, size); });
+    EXPECT_TRUE(text.empty());
+}
@@ -0,0 +1,134 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_interpolate.h"
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+// 8 位整数成员
+struct Px {
+    std::uint8_t v, w;
+
+    DEFINE_STRUCT_OPERATORS(Px, v, w)
+};
+
+// 非侵入式四元数
+struct Quat {
+    double x, y, z, w;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Quat, x, y, z, w)
+
+// 嵌套成员与数组成员, 成员类型不同
+struct Keyframe {
+    Vector3D position;
+    Color tint;
+    float weights[2];
+
+    DEFINE_STRUCT_OPERATORS(Keyframe, position, tint, weights)
+};
+
+TEST(InterpolateTest, Lerp) {
+    Vector3D a{ 0.0f, 10.0f, -4.0f };
+    Vector3D b{ 1.0f, 20.0f, 4.0f };
+    EXPECT_TRUE(dmopex::lerp(a, b, 0.0f) == a);
+    EXPECT_TRUE(dmopex::lerp(a, b, 1.0f) == b);
+    EXPECT_TRUE(dmopex::lerp(a, b, 0.25f) == (Vector3D{ 0.25f, 12.5f, -2.0f }));
+
+    // 整数成员四舍五入
+    Color c = dmopex::lerp(Color{ 0, 0, 255, 10 }, Color{ 255, 3, 0, 10 }, 0.5);
+    EXPECT_TRUE(c == (Color{ 128, 2, 128, 10 }));
+    EXPECT_TRUE((dmopex::lerp(Color{ 0, 0, 0, 0 }, Color{ -3, 0, 0, 0 }, 0.5)) == (Color{ -2, 0, 0, 0 }));
+
+    Keyframe k = dmopex::lerp(Keyframe{ { 0, 0, 0 }, { 0, 0, 0, 0 }, { 0, 1 } }, Keyframe{ { 2, 4, 6 }, { 10, 20, 30, 40 }, { 1, 0 } }, 0.5f);
+    EXPECT_TRUE(k == (Keyframe{ { 1, 2, 3 }, { 5, 10, 15, 20 }, { 0.5f, 0.5f } }));
+
+    EXPECT_DOUBLE_EQ(dmopex::lerp(2.0, 4.0, 0.75), 3.5);
+}
+
+// 超出整数成员范围时饱和, 不回绕
+TEST(InterpolateTest, IntegerSaturation) {
+    EXPECT_TRUE(dmopex::lerp(Px{ 250, 0 }, Px{ 255, 5 }, 1.5f) == (Px{ 255, 8 }));
+    EXPECT_TRUE(dmopex::lerp(Px{ 250, 0 }, Px{ 255, 5 }, -1.0f) == (Px{ 245, 0 }));
+    EXPECT_TRUE(dmopex::lerp(Color{ 0, 0, 0, 0 }, Color{ 2000000000, 0, 0, 0 }, 2.0f) == (Color{ 2147483647, 0, 0, 0 }));
+
+    // Hermite 曲线越过端点: 286.9 与 -31.9
+    EXPECT_TRUE(dmopex::hermite(Px{ 255, 0 }, Px{ 255, 0 }, Px{ 255, 0 }, Px{ 0, 255 }, 0.5f) == (Px{ 255, 0 }));
+}
+
+TEST(InterpolateTest, Nlerp) {
+    Quat a{ 0, 0, 0, 1 };
+    Quat b{ 0, 1, 0, 0 };
+    Quat q = dmopex::nlerp(a, b, 0.5);
+    EXPECT_NEAR(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, 1.0, 1e-12);
+    EXPECT_NEAR(q.y, std::sqrt(0.5), 1e-12);
+    EXPECT_NEAR(q.w, std::sqrt(0.5), 1e-12);
+}
+
+TEST(InterpolateTest, HermiteAndBezier) {
+    Vector3D p0{ 0, 0, 0 }, m0{ 1, 0, 0 }, p1{ 1, 1, 0 }, m1{ 0, 1, 0 };
+    EXPECT_TRUE(dmopex::hermite(p0, m0, p1, m1, 0.0f) == p0);
+    EXPECT_TRUE(dmopex::hermite(p0, m0, p1, m1, 1.0f) == p1);
+    // h(0.5) = 0.5 p0 + 0.125 m0 + 0.5 p1 - 0.125 m1
+    EXPECT_TRUE(dmopex::hermite(p0, m0, p1, m1, 0.5f) == (Vector3D{ 0.625f, 0.375f, 0.0f }));
+
+    Vector3D c0{ 0, 0, 0 }, c1{ 0, 4, 0 }, c2{ 4, 4, 0 }, c3{ 4, 0, 8 };
+    EXPECT_TRUE(dmopex::bezier(c0, c1, c2, c3, 0.0f) == c0);
+    EXPECT_TRUE(dmopex::bezier(c0, c1, c2, c3, 1.0f) == c3);
+    EXPECT_TRUE(dmopex::bezier(c0, c1, c2, c3, 0.5f) == (Vector3D{ 2.0f, 3.0f, 1.0f }));
+}
+
+template<typename T, typename Make>
+static void expect_batch_matches_scalar(Make make) {
+    for (std::size_t n : { 0u, 1u, 15u, 16u, 17u, 100u }) {
+        std::vector<T> a, b, c, d, out(n);
+        std::vector<float> t;
+        for (std::size_t i = 0; i < n; ++i) {
+            a.push_back(make(int(i)));
+            b.push_back(make(int(i) * 3 + 1));
+            c.push_back(make(int(i) - 7));
+            d.push_back(make(int(i) * 2));
+            t.push_back(float(i % 11) / 10.0f);
+        }
+
+        dmopex::batch_lerp<T>(a, b, t, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::lerp(a[i], b[i], t[i]));
+        }
+        dmopex::batch_hermite<T>(a, b, c, d, t, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::hermite(a[i], b[i], c[i], d[i], t[i]));
+        }
+        dmopex::batch_bezier<T>(a, b, c, d, t, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::bezier(a[i], b[i], c[i], d[i], t[i]));
+        }
+    }
+}
+
+TEST(InterpolateTest, BatchMatchesScalar) {
+    static_assert(dmopex::interp_detail::flat<float>::value, "float columns are vectorized");
+    static_assert(!dmopex::interp_detail::flat<Vector3D>::value, "arrays of structs go element by element");
+
+    expect_batch_matches_scalar<Vector3D>([](int i) { return Vector3D{ float(i), float(i) * 0.5f, float(-i) }; });
+    expect_batch_matches_scalar<Quat>([](int i) { return Quat{ double(i), 1.0, -0.25 * i, 2.0 }; });
+    expect_batch_matches_scalar<Color>([](int i) { return Color{ i, 2 * i, 255 - i, 7 }; });
+    expect_batch_matches_scalar<Keyframe>([](int i) {
+        return Keyframe{ { float(i), 1.0f, 2.0f }, { i, i, i, i }, { float(i), 0.5f } };
+    });
+    // 结构体数组拆成列 (SoA) 时逐列插值
+    expect_batch_matches_scalar<float>([](int i) { return float(i) * 0.25f; });
+}
@@ -0,0 +1,114 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_json.h"
+#include "gtest.h"
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+struct Point2D {
+    double x, y;
+
+    Point2D() = default;
+    Point2D(double x_, double y_) : x(x_), y(y_) {}
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+struct Vector3D {
+    double x, y, z;
+
+    Vector3D() = default;
+    Vector3D(double x_, double y_, double z_) : x(x_), y(y_), z(z_) {}
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    Color() = default;
+    Color(int r_, int g_, int b_, int a_ = 255) : r(r_), g(g_), b(b_), a(a_) {}
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Color, r, g, b, a)
+
+// 嵌套结构体与数组成员
+struct Entity {
+    std::string name;
+    Vector3D pos;
+    Color tint;
+    std::array<float, 3> scale;
+    int flags[2];
+    std::vector<Point2D> path;
+    bool alive;
+};
+
+bool operator==(const Entity& lhs, const Entity& rhs) {
+    return lhs.name == rhs.name && lhs.pos == rhs.pos && lhs.tint == rhs.tint && lhs.scale == rhs.scale &&
+        lhs.flags[0] == rhs.flags[0] && lhs.flags[1] == rhs.flags[1] && lhs.path == rhs.path && lhs.alive == rhs.alive;
+}
+
+template<>
+struct struct_access_traits<Entity> {
+    DEFINE_STRUCT_FIELDS(Entity, name, pos, tint, scale, flags, path, alive)
+};
+
+TEST(DmOpExJsonTest, WriteFlat) {
+    EXPECT_EQ(dmopex::to_json(Point2D{ 1.5, -2.5 }), R"({"x":1.5,"y":-2.5})");
+    EXPECT_EQ(dmopex::to_json(Color{ 255, 0, 0 }), R"({"r":255,"g":0,"b":0,"a":255})");
+    EXPECT_EQ(dmopex::to_json(Point2D{ 0.1, 1e300 }), R"({"x":0.1,"y":1e+300})");
+    EXPECT_EQ(dmopex::to_json(Point2D{ INFINITY, NAN }), R"({"x":null,"y":null})");
+}
+
+TEST(DmOpExJsonTest, RoundTripNested) {
+    Entity e{ "hero \"one\"\n\\", Vector3D{ 1.0 / 3, 2.0, -3.0 }, Color{ 1, 2, 3, 4 }, { 1.0f, 0.5f, 2.0f }, { 7, 8 },
+        { Point2D{ 0, 0 }, Point2D{ 1.25, -1.25 } }, true };
+
+    std::string json = dmopex::to_json(e);
+    EXPECT_EQ(json, R"({"name":"hero \"one\"\n\\","pos":{"x":0.3333333333333333,"y":2,"z":-3},)"
+                    R"("tint":{"r":1,"g":2,"b":3,"a":4},"scale":[1,0.5,2],"flags":[7,8],)"
+                    R"("path":[{"x":0,"y":0},{"x":1.25,"y":-1.25}],"alive":true})");
+
+    Entity back{};
+    auto status = dmopex::from_json(json, back);
+    ASSERT_TRUE(static_cast<bool>(status));
+    EXPECT_EQ(status.position, json.size());
+    EXPECT_TRUE(back == e);
+}
+
+// 乱序、未知字段、空白、转义
+TEST(DmOpExJsonTest, ReadOutOfOrder) {
+    Color c{ 9, 9, 9, 9 };
+    auto status = dmopex::from_json(R"( { "b" : 3, "extra": {"k": [1, "x", null, {"z": false}]}, "r":1 , "g" : 2 } )", c);
+    ASSERT_TRUE(static_cast<bool>(status));
+    EXPECT_EQ(c, Color(1, 2, 3, 9));
+
+    Entity e{};
+    status = dmopex::from_json(R"({"name":"café 😀","path":[]})", e);
+    ASSERT_TRUE(static_cast<bool>(status));
+    EXPECT_EQ(e.name, "caf\xC3\xA9 \xF0\x9F\x98\x80");
+    EXPECT_TRUE(e.path.empty());
+}
+
+TEST(DmOpExJsonTest, ReadErrors) {
+    Point2D p;
+    auto status = dmopex::from_json(R"({"x":1.5,"y":})", p);
+    EXPECT_EQ(status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(status.position, 13u);
+
+    Color c;
+    status = dmopex::from_json(R"({"r":1,"g":99999999999})", c);
+    EXPECT_EQ(status.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(status.position, 11u);
+
+    Entity e{};
+    status = dmopex::from_json(R"({"flags":[1,2,3]})", e);
+    EXPECT_EQ(status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(status.position, 13u);
+
+    status = dmopex::from_json(R"({"x":1} trailing)", p);
+    EXPECT_EQ(status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(status.position, 8u);
+}
@@ -0,0 +1,122 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_layout.h"
+#include "gtest.h"
+
+#include <sstream>
+#include <cstdint>
+#include <cstddef>
+
+// 声明顺序造成大量填充
+struct Entity {
+    char tag;
+    double x;
+    std::uint16_t flags;
+    double y;
+    std::uint8_t team;
+    int hp;
+
+    DEFINE_STRUCT_OPERATORS(Entity, tag, x, flags, y, team, hp)
+};
+
+// 建议的成员顺序
+struct PackedEntity {
+    double x;
+    double y;
+    int hp;
+    std::uint16_t flags;
+    char tag;
+    std::uint8_t team;
+
+    DEFINE_STRUCT_OPERATORS(PackedEntity, x, y, hp, flags, tag, team)
+};
+
+// 非侵入式, 没有填充
+struct Vector3D {
+    float x, y, z;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Vector3D, x, y, z)
+
+// 只注册了部分成员: 未注册的成员计入填充
+struct Partial {
+    int id;
+    int cache;
+
+    DEFINE_STRUCT_OPERATORS(Partial, id)
+};
+
+// 没有默认构造函数
+struct Anchor {
+    std::uint8_t slot;
+    double weight;
+
+    constexpr Anchor(std::uint8_t s, double w) : slot(s), weight(w) {}
+
+    DEFINE_STRUCT_OPERATORS(Anchor, slot, weight)
+};
+
+using EntityLayout = dmopex::layout<Entity>;
+
+static_assert(EntityLayout::size == sizeof(Entity), "size");
+static_assert(EntityLayout::member_bytes == 1 + 8 + 2 + 8 + 1 + 4, "member bytes");
+static_assert(EntityLayout::padding == sizeof(Entity) - 24, "padding");
+static_assert(EntityLayout::suggested_order[0] == 1 && EntityLayout::suggested_order[1] == 3 && EntityLayout::suggested_order[2] == 5 &&
+    EntityLayout::suggested_order[3] == 2 && EntityLayout::suggested_order[4] == 0 && EntityLayout::suggested_order[5] == 4,
+    "decreasing alignment, declaration order among equals");
+static_assert(EntityLayout::suggested_size == sizeof(PackedEntity), "suggested order is the packed size");
+static_assert(dmopex::layout<PackedEntity>::padding == sizeof(PackedEntity) - 24, "only tail padding left");
+static_assert(dmopex::layout<Vector3D>::padding == 0, "Vector3D is packed");
+static_assert(dmopex::layout<Partial>::padding == sizeof(int), "unregistered members count as padding");
+
+TEST(LayoutTest, Members) {
+    auto members = EntityLayout::members();
+    ASSERT_EQ(members.size(), 6u);
+    EXPECT_EQ(members[0].name, "tag");
+    EXPECT_EQ(members[0].offset, offsetof(Entity, tag));
+    EXPECT_EQ(members[1].offset, offsetof(Entity, x));
+    EXPECT_EQ(members[2].offset, offsetof(Entity, flags));
+    EXPECT_EQ(members[3].offset, offsetof(Entity, y));
+    EXPECT_EQ(members[4].offset, offsetof(Entity, team));
+    EXPECT_EQ(members[5].offset, offsetof(Entity, hp));
+    EXPECT_EQ(members[5].size, sizeof(int));
+    EXPECT_EQ(members[5].align, alignof(int));
+
+    auto vector = dmopex::layout<Vector3D>::members();
+    EXPECT_EQ(vector[2].name, "z");
+    EXPECT_EQ(vector[2].offset, offsetof(Vector3D, z));
+
+    auto anchor = dmopex::layout<Anchor>::members();
+    EXPECT_EQ(anchor[0].offset, offsetof(Anchor, slot));
+    EXPECT_EQ(anchor[1].offset, offsetof(Anchor, weight));
+}
+
+TEST(LayoutTest, Report) {
+    std::ostringstream os;
+    dmopex::print_layout<Entity>(os, "Entity");
+    const std::string report = os.str();
+    EXPECT_NE(report.find("Entity: size 40, align 8, padding 16 bytes (40.0%)"), std::string::npos) << report;
+    EXPECT_NE(report.find("suggested order: x y hp flags tag team -> size 24, saves 16 bytes"), std::string::npos) << report;
+
+    // 已经最优时不给建议
+    std::ostringstream packed;
+    dmopex::print_layout<Vector3D>(packed, "Vector3D");
+    EXPECT_EQ(packed.str().find("suggested"), std::string::npos);
+    EXPECT_NE(packed.str().find("Vector3D: size 12, align 4, padding 0 bytes\n"), std::string::npos) << packed.str();
+}
+
+DMOPEX_LAYOUT_REPORT(Vector3D)
+DMOPEX_LAYOUT_REPORT(Entity)
+DMOPEX_LAYOUT_REPORT(PackedEntity)
+
+TEST(LayoutTest, Registry) {
+    std::ostringstream os;
+    dmopex::print_layout_reports(os);
+    const std::string report = os.str();
+    std::size_t packed = report.find("PackedEntity:");
+    std::size_t vector = report.find("Vector3D:");
+    ASSERT_NE(packed, std::string::npos);
+    ASSERT_NE(vector, std::string::npos);
+    // 填充最多的排在前面, 填充相同的按注册顺序
+    EXPECT_EQ(report.find("Entity: size 40"), 0u) << report;
+    EXPECT_LT(vector, packed);
+}
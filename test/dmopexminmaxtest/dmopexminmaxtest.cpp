@@ -0,0 +1,129 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_minmax.h"
+#include "gtest.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+// 非侵入式, 无符号字节成员
+struct Texel {
+    std::uint8_t r, g, b;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Texel, r, g, b)
+
+// 嵌套成员与数组成员, 成员类型不同
+struct Sample {
+    Vector3D position;
+    short level;
+    double weights[2];
+
+    DEFINE_STRUCT_OPERATORS(Sample, position, level, weights)
+};
+
+TEST(MinMaxTest, MemberWise) {
+    Vector3D a{ 1.0f, -2.0f, 3.0f };
+    Vector3D b{ 0.5f, 4.0f, 3.0f };
+    EXPECT_TRUE(dmopex::min(a, b) == (Vector3D{ 0.5f, -2.0f, 3.0f }));
+    EXPECT_TRUE(dmopex::max(a, b) == (Vector3D{ 1.0f, 4.0f, 3.0f }));
+    EXPECT_TRUE(dmopex::abs(a) == (Vector3D{ 1.0f, 2.0f, 3.0f }));
+
+    Color c = dmopex::clamp(Color{ -20, 128, 300, 255 }, Color{ 0, 0, 0, 0 }, Color{ 255, 255, 255, 255 });
+    EXPECT_TRUE(c == (Color{ 0, 128, 255, 255 }));
+
+    Sample s = dmopex::clamp(Sample{ { 5, -5, 0 }, -7, { 2.5, -1.0 } }, Sample{ { 0, 0, 0 }, 0, { 0, 0 } }, Sample{ { 1, 1, 1 }, 10, { 1, 1 } });
+    EXPECT_TRUE(s == (Sample{ { 1, 0, 0 }, 0, { 1, 0 } }));
+    EXPECT_TRUE(dmopex::abs(Sample{ { -1, 2, -3 }, -4, { -0.5, 0.5 } }) == (Sample{ { 1, 2, 3 }, 4, { 0.5, 0.5 } }));
+
+    EXPECT_TRUE(dmopex::min(Texel{ 1, 200, 3 }, Texel{ 2, 100, 3 }) == (Texel{ 1, 100, 3 }));
+    EXPECT_TRUE((dmopex::max(std::array<int, 2>{ 1, 5 }, std::array<int, 2>{ 3, 2 }) == std::array<int, 2>{ 3, 5 }));
+    EXPECT_EQ(dmopex::clamp(7, 0, 5), 5);
+}
+
+template<typename T, typename Make>
+static void expect_batch_matches_scalar(Make make, const T& lo, const T& hi) {
+    for (std::size_t n : { 1u, 2u, 15u, 16u, 17u, 100u }) {
+        std::vector<T> a, b, out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a.push_back(make(static_cast<int>(i * 7 % 23) - 11));
+            b.push_back(make(static_cast<int>(i * 5 % 19) - 9));
+        }
+        dmopex::batch_min<T>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::min(a[i], b[i]));
+        }
+        dmopex::batch_max<T>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::max(a[i], b[i]));
+        }
+        dmopex::batch_clamp<T>(a, lo, hi, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::clamp(a[i], lo, hi));
+        }
+        dmopex::batch_abs<T>(a, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_TRUE(out[i] == dmopex::abs(a[i]));
+        }
+
+        T lower = a[0], upper = a[0];
+        for (const T& v : a) {
+            lower = dmopex::min(lower, v);
+            upper = dmopex::max(upper, v);
+        }
+        dmopex::aabb<T> box = dmopex::bounds<T>(a);
+        EXPECT_TRUE(box.lo == lower);
+        EXPECT_TRUE(box.hi == upper);
+        EXPECT_TRUE(dmopex::min_of<T>(a) == lower);
+        EXPECT_TRUE(dmopex::max_of<T>(a) == upper);
+    }
+}
+
+TEST(MinMaxTest, BatchMatchesScalar) {
+    static_assert(dmopex::minmax_detail::uniform<Vector3D>::leaves == 3, "Vector3D is a flat float array");
+    static_assert(dmopex::minmax_detail::uniform<Sample>::leaves == 0, "mixed leaves go element by element");
+
+    expect_batch_matches_scalar<float>([](int i) { return i * 0.5f; }, -1.0f, 2.0f);
+    expect_batch_matches_scalar<Vector3D>([](int i) { return Vector3D{ float(i), -0.25f * i, float(i % 5) }; },
+        Vector3D{ -1, -1, 0 }, Vector3D{ 4, 1, 2 });
+    expect_batch_matches_scalar<Color>([](int i) { return Color{ i * 40, -i, i * i, 255 - i }; },
+        Color{ 0, 0, 0, 0 }, Color{ 255, 255, 255, 255 });
+    expect_batch_matches_scalar<Texel>([](int i) { return Texel{ std::uint8_t(i * 3), std::uint8_t(i), 255 }; },
+        Texel{ 10, 20, 30 }, Texel{ 200, 100, 250 });
+    expect_batch_matches_scalar<Sample>([](int i) { return Sample{ { float(i), 1.0f, -float(i) }, short(i), { 0.5 * i, 1.0 } }; },
+        Sample{ { 0, 0, 0 }, -3, { 0, 0 } }, Sample{ { 5, 5, 5 }, 3, { 2, 2 } });
+}
+
+TEST(MinMaxTest, Bounds) {
+    std::vector<Vector3D> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.push_back(Vector3D{ float(i % 37) - 10.0f, float(i % 101) * 0.5f, -float(i) });
+    }
+    dmopex::aabb<Vector3D> box = dmopex::bounds<Vector3D>(points);
+    EXPECT_TRUE(box.lo == (Vector3D{ -10.0f, 0.0f, -999.0f }));
+    EXPECT_TRUE(box.hi == (Vector3D{ 26.0f, 50.0f, 0.0f }));
+
+    std::vector<Vector3D> one{ Vector3D{ 1, 2, 3 } };
+    box = dmopex::bounds<Vector3D>(one);
+    EXPECT_TRUE(box.lo == one[0] && box.hi == one[0]);
+
+    // 批量 clamp 可原地进行
+    std::vector<Color> colors{ { -1, 256, 7, 1000 }, { 3, -3, 300, 0 } };
+    dmopex::batch_clamp<Color>(colors, Color{ 0, 0, 0, 0 }, Color{ 255, 255, 255, 255 }, colors);
+    EXPECT_TRUE(colors[0] == (Color{ 0, 255, 7, 255 }));
+    EXPECT_TRUE(colors[1] == (Color{ 3, 0, 255, 0 }));
+}
@@ -1,6 +1,9 @@
 ﻿#include "dmopex_non_intrusive.h" // 使用新的非侵入式头文件
 #include "gtest.h"
 
+#include <string>
+#include <sstream>
+
 class env_dmopex
 {
 public:
@@ -368,3 +371,135 @@ TEST_F(DMOPEX_MaxParamsTest, SubtractionOperator) {
     MaxParamsStruct difference = s1 - s2;
     EXPECT_EQ(difference, expected_s);
 }
+
+// 字段元数据测试
+static_assert(dmopex::is_reflected_v<MaxParamsStruct>, "MaxParamsStruct should be reflected");
+static_assert(dmopex::fields<MaxParamsStruct>::size == 64, "MaxParamsStruct has 64 members");
+static_assert(dmopex::fields<MaxParamsStruct>::names[63] == "m64", "last member is m64");
+static_assert(dmopex::fields<Color>::index_of("b") == 2, "Color::b is member 2");
+static_assert(std::is_same_v<dmopex::fields<Color>::types, std::tuple<int, int, int, int>>, "Color members are int");
+
+TEST_F(DMOPEX_MaxParamsTest, FieldMetadata) {
+    InitializeStruct(s1, 1);
+    dmopex::get<41>(s1) = 100;
+    EXPECT_EQ(s1.m42, 100);
+
+    int total = 0;
+    dmopex::for_each_field(s1, [&](std::string_view name, int value) {
+        if (name == "m42") {
+            EXPECT_EQ(value, 100);
+        }
+        total += value;
+    });
+    EXPECT_EQ(total, 163);
+    EXPECT_EQ(dmopex::fields<MaxParamsStruct>::index_of("m42"), 41u);
+}
+
+// 嵌套结构体: 成员本身是非侵入式反射结构体, 且位于其他命名空间
+namespace game {
+    struct Velocity {
+        double dx, dy;
+    };
+}
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(game::Velocity, dx, dy);
+
+struct Body {
+    Vector3D pos;
+    game::Velocity vel;
+    Color tint;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Body, pos, vel, tint);
+
+static_assert(dmopex::leaf_count_v<Body> == 9, "Body flattens to 3 + 2 + 4 leaves");
+
+TEST_F(DmOpExTest, NestedStructs) {
+    Body a{ Vector3D(1.0, 2.0, 3.0), game::Velocity{ 0.5, -0.5 }, Color(10, 20, 30, 40) };
+    Body b{ Vector3D(1.0, 1.0, 1.0), game::Velocity{ 1.5, 1.5 }, Color(1, 1, 1, 1) };
+
+    Body sum = a + b;
+    EXPECT_EQ(sum.pos, Vector3D(2.0, 3.0, 4.0));
+    EXPECT_EQ(sum.vel.dx, 2.0);
+    EXPECT_EQ(sum.vel.dy, 1.0);
+    EXPECT_EQ(sum.tint, Color(11, 21, 31, 41));
+
+    sum -= b;
+    EXPECT_EQ(sum, a);
+    EXPECT_NE(sum, b);
+
+    std::ostringstream oss;
+    oss << a;
+    EXPECT_EQ(oss.str(), "((1, 2, 3), (0.5, -0.5), (10, 20, 30, 40))");
+}
+
+// 非侵入式聚合体, 运算符可在编译期求值
+struct Rgb {
+    int r, g, b;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Rgb, r, g, b);
+
+constexpr Rgb kPalette[] = { Rgb{ 255, 0, 0 } + Rgb{ 0, 255, 0 }, Rgb{ 10, 20, 30 } * Rgb{ 2, 2, 2 } - Rgb{ 1, 1, 1 } };
+
+constexpr Rgb scaled(Rgb c) {
+    c *= Rgb{ 3, 3, 3 };
+    c /= Rgb{ 2, 2, 2 };
+    return c;
+}
+
+static_assert(kPalette[0] == Rgb{ 255, 255, 0 }, "constexpr operator+");
+static_assert(kPalette[1] == Rgb{ 19, 39, 59 }, "constexpr operator* and operator-");
+static_assert(scaled(Rgb{ 2, 4, 7 }) == Rgb{ 3, 6, 10 }, "constexpr compound assignment");
+static_assert(scaled(Rgb{ 2, 4, 7 }) != Rgb{ 3, 6, 11 }, "constexpr operator!=");
+
+static_assert(noexcept(std::declval<const Rgb&>() + std::declval<const Rgb&>()), "int members do not throw");
+static_assert(noexcept(std::declval<Body&>() -= std::declval<const Body&>()), "nested members do not throw");
+static_assert(noexcept(std::declval<const Body&>() == std::declval<const Body&>()), "comparison does not throw");
+
+// 手写的 traits: to_tuple / from_tuple 不是 noexcept, 运算符也就不是
+struct Meters {
+    double value;
+};
+template<>
+struct struct_access_traits<Meters> {
+    static constexpr auto to_tuple(const Meters& m) { return std::make_tuple(m.value); }
+
+    template<typename TupleType>
+    static constexpr Meters from_tuple(const TupleType& t) { return Meters{ std::get<0>(t) }; }
+};
+
+static_assert(Meters{ 1.5 } + Meters{ 2.0 } == Meters{ 3.5 }, "constexpr through hand-written traits");
+static_assert(!noexcept(std::declval<const Meters&>() + std::declval<const Meters&>()), "to_tuple may throw");
+
+TEST_F(DmOpExTest, ConstexprOperators) {
+    EXPECT_EQ(kPalette[0], (Rgb{ 255, 255, 0 }));
+    EXPECT_EQ((Meters{ 1.0 } * Meters{ 4.0 }).value, 4.0);
+}
+
+// 未注册的类型不受全局模板运算符影响, 使用自身的运算符
+struct Ticket {
+    int id;
+};
+
+constexpr int operator+(const Ticket& a, const Ticket& b) { return a.id + b.id; }
+
+std::ostream& operator<<(std::ostream& os, const Ticket& t) { return os << "#" << t.id; }
+
+template<typename T, typename = void>
+struct has_equal : std::false_type {};
+
+template<typename T>
+struct has_equal<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>> : std::true_type {};
+
+static_assert(!has_equal<Ticket>::value, "no operator== for types without struct_access_traits");
+static_assert(has_equal<Point2D>::value, "operator== for registered types");
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+static_assert(struct_access_traits_defined<Meters> && !struct_access_traits_defined<Ticket>, "C++20 constraint");
+#elif __cplusplus > 201703L
+#error "C++20 build of this test without concepts: the concept path is not checked"
+#endif
+
+TEST_F(DmOpExTest, UnrelatedTypes) {
+    EXPECT_EQ(Ticket{ 2 } + Ticket{ 3 }, 5);
+    std::ostringstream os;
+    os << Ticket{ 7 } << ' ' << std::string("text") + "!";
+    EXPECT_EQ(os.str(), "#7 text!");
+}
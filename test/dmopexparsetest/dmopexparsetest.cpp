@@ -0,0 +1,176 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_format.h"
+#include "dmopex_parse.h"
+#include "gtest.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Point2D {
+    double x, y;
+
+    Point2D() = default;
+    Point2D(double x_, double y_) : x(x_), y(y_) {}
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+struct Vector3D {
+    double x, y, z;
+
+    Vector3D() = default;
+    Vector3D(double x_, double y_, double z_) : x(x_), y(y_), z(z_) {}
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    Color() = default;
+    Color(int r_, int g_, int b_, int a_ = 255) : r(r_), g(g_), b(b_), a(a_) {}
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Color, r, g, b, a)
+
+struct Sprite {
+    Vector3D pos;
+    Color tint;
+    unsigned id;
+    bool visible;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Sprite, pos, tint, id, visible)
+
+// 解析 operator<< 的输出
+TEST(DmOpExParseTest, RoundTrip) {
+    Point2D p{ 1.5, -2.25 };
+    std::ostringstream oss;
+    oss << p;
+
+    auto result = dmopex::parse<Point2D>(oss.str());
+    ASSERT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.value, p);
+    EXPECT_EQ(result.status.position, oss.str().size());
+
+    Color c;
+    ASSERT_TRUE(static_cast<bool>(dmopex::parse("  ( 255 ,0,\t0 , 128 )  ", c)));
+    EXPECT_EQ(c, Color(255, 0, 0, 128));
+
+    Sprite s{ Vector3D{ 1.0, 2.0, 3.0 }, Color{ 10, 20, 30 }, 7u, true };
+    auto sprite = dmopex::parse<Sprite>(fmt::format("{}", s));
+    ASSERT_TRUE(static_cast<bool>(sprite));
+    EXPECT_EQ(sprite.value, s);
+}
+
+// char 成员按单个字符输出与解析
+struct Tag {
+    char c;
+    int n;
+    char marks[3];
+
+    DEFINE_STRUCT_OPERATORS(Tag, c, n, marks)
+};
+
+TEST(DmOpExParseTest, CharMembers) {
+    for (char c : { 'x', ' ', ',', ')', ':' }) {
+        Tag t{ c, 3, { '[', ' ', ']' } };
+        std::ostringstream oss;
+        oss << t;
+
+        auto streamed = dmopex::parse<Tag>(oss.str());
+        ASSERT_TRUE(static_cast<bool>(streamed)) << oss.str();
+        EXPECT_EQ(streamed.value, t);
+
+        auto named = dmopex::parse<Tag>(fmt::format("{:n}", t));
+        ASSERT_TRUE(static_cast<bool>(named)) << fmt::format("{:n}", t);
+        EXPECT_EQ(named.value, t);
+    }
+
+    std::ostringstream oss;
+    oss << Tag{ 'x', 3, { 'a', 'b', 'c' } };
+    EXPECT_EQ(oss.str(), "(x, 3, [a, b, c])");
+}
+
+// 带字段名的格式
+TEST(DmOpExParseTest, NamedFields) {
+    auto result = dmopex::parse<Point2D>("(x: 1.5, y: 2.5)");
+    ASSERT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.value, Point2D(1.5, 2.5));
+
+    Sprite s{ Vector3D{ 1.0, 2.0, 3.0 }, Color{ 10, 20, 30 }, 7u, false };
+    auto sprite = dmopex::parse<Sprite>(fmt::format("{:n}", s));
+    ASSERT_TRUE(static_cast<bool>(sprite));
+    EXPECT_EQ(sprite.value, s);
+
+    auto wrong = dmopex::parse<Point2D>("(x: 1.5, z: 2.5)");
+    EXPECT_EQ(wrong.status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(wrong.status.position, 9u);
+
+    auto special = dmopex::parse<Point2D>("(inf, -inf)");
+    ASSERT_TRUE(static_cast<bool>(special));
+    EXPECT_GT(special.value.x, 1e308);
+}
+
+// 错误位置
+TEST(DmOpExParseTest, ErrorPositions) {
+    auto missing = dmopex::parse<Point2D>("(1.5 2.5)");
+    EXPECT_EQ(missing.status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(missing.status.position, 5u);
+
+    auto bad_number = dmopex::parse<Color>("(1, 2, x, 4)");
+    EXPECT_EQ(bad_number.status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(bad_number.status.position, 7u);
+
+    auto overflow = dmopex::parse<Color>("(1, 99999999999, 3, 4)");
+    EXPECT_EQ(overflow.status.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(overflow.status.position, 4u);
+
+    auto trailing = dmopex::parse<Point2D>("(1, 2) x");
+    EXPECT_EQ(trailing.status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(trailing.status.position, 7u);
+
+    auto truncated = dmopex::parse<Point2D>("(1, 2");
+    EXPECT_EQ(truncated.status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(truncated.status.position, 5u);
+}
+
+// 批量按行解析
+TEST(DmOpExParseTest, ParseLines) {
+    std::vector<Vector3D> expected;
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        expected.emplace_back(i * 0.5, -i, i * 0.25);
+        text += fmt::format("{}\n", expected.back());
+        if (i % 100 == 0) {
+            text += "\n";
+        }
+    }
+
+    for (unsigned threads : { 1u, 3u, 8u }) {
+        dmopex::parse_lines_options options;
+        options.threads = threads;
+        options.min_chunk_bytes = 64;
+
+        std::vector<Vector3D> parsed;
+        auto status = dmopex::parse_lines(text, parsed, options);
+        ASSERT_TRUE(static_cast<bool>(status));
+        EXPECT_EQ(parsed, expected);
+    }
+}
+
+TEST(DmOpExParseTest, ParseLinesError) {
+    std::string text = "(1, 2)\n(3, 4)\n\n(5, six)\n(7, 8)\n";
+
+    dmopex::parse_lines_options options;
+    options.threads = 2;
+    options.min_chunk_bytes = 1;
+
+    std::vector<Point2D> parsed;
+    auto status = dmopex::parse_lines(text, parsed, options);
+    EXPECT_EQ(status.ec, std::errc::invalid_argument);
+    EXPECT_EQ(status.line, 3u);
+    EXPECT_EQ(status.position, text.find("six"));
+    ASSERT_EQ(parsed.size(), 2u);
+    EXPECT_EQ(parsed[1], Point2D(3, 4));
+}
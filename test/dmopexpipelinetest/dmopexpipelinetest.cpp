@@ -0,0 +1,97 @@
+﻿#include "dmopex.h"
+#include "dmopex_pipeline.h"
+#include "gtest.h"
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 饱和策略在融合后保持不变
+struct Pixel {
+    std::uint8_t r, g, b;
+
+    DEFINE_STRUCT_OPERATORS_EX(Pixel, dmopex::saturate_policy, r, g, b)
+};
+
+// 成员类型不同, 逐叶子计算
+struct Body {
+    Vector3D position;
+    int mass;
+    double extents[2];
+
+    DEFINE_STRUCT_OPERATORS(Body, position, mass, extents)
+};
+
+// 表达式只保存数组指针, 临时容器不接受
+template<typename Range, typename = void>
+struct has_lazy : std::false_type {};
+
+template<typename Range>
+struct has_lazy<Range, std::void_t<decltype(dmopex::lazy(std::declval<Range>()))>> : std::true_type {};
+
+static_assert(has_lazy<std::vector<Vector3D>&>::value && has_lazy<const std::vector<Vector3D>&>::value, "arrays that outlive the expression");
+static_assert(has_lazy<dmopex::span<const Vector3D>>::value && has_lazy<Vector3D (&)[4]>::value, "views and C arrays");
+static_assert(!has_lazy<std::vector<Vector3D>>::value && !has_lazy<const std::vector<Vector3D>>::value, "temporary containers");
+
+// 不是块大小整数倍的元素个数
+constexpr std::size_t kCount = 1000;
+
+TEST(PipelineTest, MatchesUnfused) {
+    std::vector<Vector3D> a(kCount), b(kCount), s(kCount), f(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float v = static_cast<float>(i);
+        a[i] = Vector3D{ v, -v, 0.5f * v };
+        b[i] = Vector3D{ 1, 2, 3 };
+        s[i] = Vector3D{ 2, 0.5f, -1 };
+        f[i] = Vector3D{ v, v, v };
+    }
+
+    auto e = (dmopex::lazy(a) + dmopex::lazy(b)) * dmopex::lazy(s) - dmopex::lazy(f);
+    EXPECT_EQ(e.size(), kCount);
+    std::vector<Vector3D> out(kCount);
+    dmopex::evaluate(e, out);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_TRUE(out[i] == (a[i] + b[i]) * s[i] - f[i]);
+    }
+
+    // 单个值作用于每个元素, 可在任一侧
+    std::vector<Vector3D> scaled(kCount);
+    dmopex::evaluate(Vector3D{ 1, 1, 1 } - dmopex::lazy(a) * Vector3D{ 2, 2, 2 }, scaled);
+    EXPECT_TRUE(scaled[10] == (Vector3D{ -19, 21, -9 }));
+
+    // 右侧为子表达式
+    std::vector<Vector3D> nested(kCount);
+    dmopex::evaluate(dmopex::lazy(f) / (dmopex::lazy(b) + dmopex::lazy(b)), nested);
+    EXPECT_TRUE(nested[6] == f[6] / (b[6] + b[6]));
+}
+
+TEST(PipelineTest, OutputIsAnInput) {
+    std::vector<Vector3D> a(kCount, Vector3D{ 1, 2, 3 }), b(kCount, Vector3D{ 10, 10, 10 });
+    // 输出就是右侧的输入, 不能把左侧结果先写进去
+    dmopex::evaluate((dmopex::lazy(b) + dmopex::lazy(b)) * dmopex::lazy(a), a);
+    EXPECT_TRUE(a[0] == (Vector3D{ 20, 40, 60 }));
+    EXPECT_TRUE(a[kCount - 1] == (Vector3D{ 20, 40, 60 }));
+
+    dmopex::arena scratch;
+    dmopex::span<Vector3D> c = dmopex::evaluate(scratch, dmopex::lazy(a) - dmopex::lazy(b));
+    EXPECT_EQ(c.size(), kCount);
+    EXPECT_TRUE(c[5] == (Vector3D{ 10, 30, 50 }));
+}
+
+TEST(PipelineTest, Policies) {
+    std::vector<Pixel> pixels(37, Pixel{ 200, 100, 0 });
+    std::vector<Pixel> out(pixels.size());
+    dmopex::evaluate(dmopex::lazy(pixels) + dmopex::lazy(pixels) - Pixel{ 50, 50, 50 }, out);
+    EXPECT_TRUE(out[36] == (Pixel{ 205, 150, 0 }));
+
+    std::vector<Body> bodies(kCount, Body{ { 1, 2, 3 }, 4, { 0.5, 1.5 } });
+    std::vector<Body> twice(kCount);
+    dmopex::evaluate(dmopex::lazy(bodies) * Body{ { 2, 2, 2 }, 2, { 2, 2 } } + dmopex::lazy(bodies), twice);
+    EXPECT_TRUE(twice[kCount - 1] == (Body{ { 3, 6, 9 }, 12, { 1.5, 4.5 } }));
+}
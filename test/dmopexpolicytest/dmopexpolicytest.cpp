@@ -0,0 +1,239 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_color.h"
+#include "dmopex_batch.h"
+#include "gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <stdexcept>
+#include <utility>
+
+// 默认策略: 整数回绕
+struct Counter {
+    std::uint8_t lo;
+    std::int16_t hi;
+
+    DEFINE_STRUCT_OPERATORS(Counter, lo, hi)
+};
+
+// 饱和策略
+struct Pixel {
+    std::uint8_t v;
+    std::int8_t d;
+    double w;
+
+    DEFINE_STRUCT_OPERATORS_EX(Pixel, dmopex::saturate_policy, v, d, w)
+};
+
+// 检查策略
+struct Account {
+    int balance;
+    unsigned count;
+
+    DEFINE_STRUCT_OPERATORS_EX(Account, dmopex::checked_policy, balance, count)
+};
+
+// 非侵入式, 饱和策略
+struct Gray {
+    std::uint16_t level;
+    std::int32_t offset;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE_EX(Gray, dmopex::saturate_policy, level, offset)
+
+// 非侵入式, 默认策略
+struct Tick {
+    std::uint8_t n;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Tick, n)
+
+static_assert(std::is_same_v<dmopex::policy_of_t<Counter>, dmopex::wrap_policy>, "default policy is wrap");
+static_assert(std::is_same_v<dmopex::policy_of_t<Pixel>, dmopex::saturate_policy>, "intrusive policy");
+static_assert(std::is_same_v<dmopex::policy_of_t<Gray>, dmopex::saturate_policy>, "non-intrusive policy");
+static_assert(std::is_same_v<dmopex::policy_of_t<Tick>, dmopex::wrap_policy>, "non-intrusive default policy");
+static_assert(dmopex::saturate_policy::add<std::int8_t>(100, 100) == 127, "constexpr saturation");
+static_assert(dmopex::saturate_policy::mul<int>(-65536, 65536) == INT32_MIN, "signed saturation");
+static_assert(noexcept(std::declval<const Pixel&>() * std::declval<const Pixel&>()), "saturation never throws");
+static_assert(noexcept(std::declval<const Gray&>() / std::declval<const Gray&>()), "non-intrusive saturation never throws");
+static_assert(!noexcept(std::declval<const Account&>() + std::declval<const Account&>()), "checked integers may throw");
+static_assert(Account{ 1, 2 } + Account{ 3, 4 } == Account{ 4, 6 }, "checked policy is constexpr while nothing overflows");
+
+TEST(PolicyTest, Wrap) {
+    Counter a{ 250, 32000 };
+    Counter b{ 10, 1000 };
+    Counter sum = a + b;
+    EXPECT_EQ(sum.lo, 4);
+    EXPECT_EQ(sum.hi, static_cast<std::int16_t>(-32536));
+
+    Counter diff = Counter{ 0, -32768 } - Counter{ 1, 1 };
+    EXPECT_EQ(diff.lo, 255);
+    EXPECT_EQ(diff.hi, 32767);
+
+    Tick t = Tick{ 200 } * Tick{ 2 };
+    EXPECT_EQ(t.n, 144);
+}
+
+TEST(PolicyTest, Saturate) {
+    Pixel a{ 200, 100, 1.5 };
+    Pixel b{ 100, 100, 2.0 };
+    EXPECT_EQ(a + b, (Pixel{ 255, 127, 3.5 }));
+    EXPECT_EQ(b - a, (Pixel{ 0, 0, 0.5 }));
+    EXPECT_EQ((Pixel{ 0, -100, 1.0 } - Pixel{ 0, 100, 1.0 }), (Pixel{ 0, -128, 0.0 }));
+    EXPECT_EQ(a * b, (Pixel{ 255, 127, 3.0 }));
+    EXPECT_EQ((Pixel{ 3, -100, 1.0 } * Pixel{ 4, 2, 1.0 }), (Pixel{ 12, -128, 1.0 }));
+    EXPECT_EQ((Pixel{ 7, -128, 1.0 } / Pixel{ 0, -1, 2.0 }), (Pixel{ 255, 127, 0.5 }));
+
+    a += b;
+    EXPECT_EQ(a.v, 255);
+
+    Gray g = Gray{ 60000, 2000000000 } + Gray{ 10000, 2000000000 };
+    EXPECT_EQ(g.level, 65535);
+    EXPECT_EQ(g.offset, INT32_MAX);
+    g = Gray{ 5, -2000000000 } - Gray{ 10, 2000000000 };
+    EXPECT_EQ(g.level, 0);
+    EXPECT_EQ(g.offset, INT32_MIN);
+}
+
+TEST(PolicyTest, Checked) {
+    Account a{ 100, 1 };
+    EXPECT_EQ((a + Account{ 50, 2 }), (Account{ 150, 3 }));
+    EXPECT_THROW((a + Account{ INT32_MAX, 0 }), std::overflow_error);
+    EXPECT_THROW((a - Account{ 0, 2 }), std::overflow_error);
+    EXPECT_THROW((a * Account{ INT32_MAX, 1 }), std::overflow_error);
+    EXPECT_THROW((a / Account{ 0, 1 }), std::domain_error);
+    EXPECT_THROW((Account{ INT32_MIN, 1 } / Account{ -1, 1 }), std::overflow_error);
+
+    // Failed compound assignment leaves the target untouched
+    EXPECT_THROW((a += Account{ INT32_MAX, 0 }), std::overflow_error);
+    EXPECT_EQ(a, (Account{ 100, 1 }));
+}
+
+TEST(ColorTest, Rgba8Operators) {
+    using dmopex::rgba8;
+    EXPECT_EQ((rgba8{ 200, 100, 0, 255 } + rgba8{ 100, 100, 0, 0 }), (rgba8{ 255, 200, 0, 255 }));
+    EXPECT_EQ((rgba8{ 10, 100, 0, 255 } - rgba8{ 20, 50, 0, 0 }), (rgba8{ 0, 50, 0, 255 }));
+    EXPECT_EQ((rgba8{ 2, 100, 0, 1 } * rgba8{ 3, 100, 9, 255 }), (rgba8{ 6, 255, 0, 255 }));
+    EXPECT_EQ(dmopex::modulate(rgba8{ 255, 128, 0, 255 }, rgba8{ 255, 255, 255, 128 }), (rgba8{ 255, 128, 0, 128 }));
+    EXPECT_EQ(dmopex::modulate(rgba8{ 200, 100, 50, 0 }, rgba8{ 128, 128, 128, 128 }), (rgba8{ 100, 50, 25, 0 }));
+}
+
+TEST(ColorTest, BatchMatchesScalar) {
+    using dmopex::rgba8;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> channel(0, 255);
+    auto random_color = [&] {
+        return rgba8{ std::uint8_t(channel(rng)), std::uint8_t(channel(rng)), std::uint8_t(channel(rng)), std::uint8_t(channel(rng)) };
+    };
+
+    // Sizes around the vector widths exercise the scalar tail
+    for (std::size_t n : { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1000 }) {
+        std::vector<rgba8> a(n), b(n), out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = random_color();
+            b[i] = random_color();
+        }
+
+        dmopex::batch_add<rgba8>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] + b[i]) << "n=" << n << " i=" << i;
+        }
+        dmopex::batch_sub<rgba8>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] - b[i]) << "n=" << n << " i=" << i;
+        }
+        dmopex::batch_mul<rgba8>(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] * b[i]) << "n=" << n << " i=" << i;
+        }
+        dmopex::batch_modulate(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], dmopex::modulate(a[i], b[i])) << "n=" << n << " i=" << i;
+        }
+
+        // In place
+        std::vector<rgba8> expected(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            expected[i] = a[i] + b[i];
+        }
+        dmopex::batch_add<rgba8>(a, b, a);
+        ASSERT_EQ(a, expected);
+    }
+}
+
+TEST(ColorTest, ModulateExhaustive) {
+    for (unsigned x = 0; x < 256; ++x) {
+        for (unsigned y = 0; y < 256; ++y) {
+            unsigned expected = (x * y * 2 + 255) / 510;
+            ASSERT_EQ(dmopex::color_detail::mul_norm(std::uint8_t(x), std::uint8_t(y)), expected) << x << " * " << y;
+        }
+    }
+}
+
+TEST(BatchTest, GenericStructs) {
+    std::vector<Pixel> a{ { 200, 100, 1.0 }, { 1, -5, 2.0 } };
+    std::vector<Pixel> b{ { 100, 100, 3.0 }, { 2, -5, 4.0 } };
+    std::vector<Pixel> out(2);
+    dmopex::batch_add<Pixel>(a, b, out);
+    EXPECT_EQ(out[0], (Pixel{ 255, 127, 4.0 }));
+    EXPECT_EQ(out[1], (Pixel{ 3, -10, 6.0 }));
+
+    std::vector<Gray> g{ { 10, 10 } };
+    std::vector<Gray> h{ { 20, 20 } };
+    dmopex::batch_sub<Gray>(g, h, g);
+    EXPECT_EQ(g[0].level, 0);
+    EXPECT_EQ(g[0].offset, -10);
+}
+
+// 嵌套结构体的批量运算
+struct Vec3 {
+    double x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vec3, x, y, z)
+};
+
+struct Segment {
+    Vec3 from, to;
+
+    DEFINE_STRUCT_OPERATORS(Segment, from, to)
+};
+
+struct Tinted {
+    Vec3 pos;
+    dmopex::rgba8 color;
+
+    DEFINE_STRUCT_OPERATORS(Tinted, pos, color)
+};
+
+static_assert(dmopex::batch_detail::flat_layout<Segment>::value, "Segment is six packed doubles");
+static_assert(!dmopex::batch_detail::flat_layout<Tinted>::value, "Tinted mixes leaf types");
+static_assert(!dmopex::batch_detail::flat_layout<Pixel>::value, "Pixel mixes leaf types");
+
+TEST(BatchTest, NestedStructsAreFlattened) {
+    std::vector<Segment> segments, offsets, out(37);
+    std::vector<Tinted> tinted, tints, tinted_out(37);
+    for (int i = 0; i < 37; ++i) {
+        segments.push_back(Segment{ Vec3{ 1.0 * i, 2.0, 3.0 }, Vec3{ 4.0, 5.0 * i, 6.0 } });
+        offsets.push_back(Segment{ Vec3{ 0.5, 0.5, 0.5 }, Vec3{ -1.0, 2.0, 0.25 * i } });
+        tinted.push_back(Tinted{ Vec3{ 1.0, 2.0, 3.0 * i }, dmopex::rgba8{ std::uint8_t(7 * i), 200, 3, 255 } });
+        tints.push_back(Tinted{ Vec3{ 2.0, 2.0, 2.0 }, dmopex::rgba8{ 100, 100, 3, 1 } });
+    }
+
+    dmopex::batch_add<Segment>(segments, offsets, out);
+    for (int i = 0; i < 37; ++i) {
+        ASSERT_EQ(out[i], segments[i] + offsets[i]) << i;
+    }
+    dmopex::batch_mul<Segment>(segments, offsets, out);
+    for (int i = 0; i < 37; ++i) {
+        ASSERT_EQ(out[i], segments[i] * offsets[i]) << i;
+    }
+
+    dmopex::batch_add<Tinted>(tinted, tints, tinted_out);
+    for (int i = 0; i < 37; ++i) {
+        ASSERT_EQ(tinted_out[i], tinted[i] + tints[i]) << i;
+    }
+    EXPECT_EQ(tinted_out[36].color, (dmopex::rgba8{ 255, 255, 6, 255 }));
+    dmopex::batch_sub<Tinted>(tinted, tints, tinted_out);
+    EXPECT_EQ(tinted_out[0].color, (dmopex::rgba8{ 0, 100, 0, 254 }));
+    EXPECT_EQ(tinted_out[0].pos, (Vec3{ -1.0, 0.0, -2.0 }));
+}
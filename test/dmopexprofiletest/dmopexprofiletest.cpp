@@ -0,0 +1,102 @@
+﻿// 本测试以开启计数的方式编译, 需在包含头文件之前定义开关; 以 -DDMOPEX_PROFILE 构建时沿用命令行的定义
+#ifndef DMOPEX_PROFILE
+#define DMOPEX_PROFILE
+#ifndef DMOPEX_PROFILE_CYCLES
+#define DMOPEX_PROFILE_CYCLES 4
+#endif
+#endif
+
+#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "gtest.h"
+
+#include <thread>
+#include <vector>
+#include <sstream>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 非侵入式定义的类型同样计数
+struct Money {
+    long long cents;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Money, cents)
+
+std::uint64_t calls_of(std::string_view type, dmopex::profile_op op) {
+    for (const dmopex::profile_entry& entry : dmopex::profile_snapshot()) {
+        if (entry.type == type && entry.op == op) {
+            return entry.calls;
+        }
+    }
+    return 0;
+}
+
+// 常量求值不计数, 运算符仍可用于编译期
+constexpr Vector3D kSum = Vector3D{ 1, 2, 3 } + Vector3D{ 1, 1, 1 };
+static_assert(kSum.z == 4, "operators stay constexpr when profiled");
+
+TEST(ProfileTest, CountsCalls) {
+    dmopex::profile_reset();
+    Vector3D a{ 1, 2, 3 }, b{ 4, 5, 6 };
+    for (int i = 0; i < 10; ++i) {
+        a = a + b;
+    }
+    a -= b;
+    a = a * b / b;
+    EXPECT_TRUE(a != b);
+    Money m{ 100 };
+    m += Money{ 5 };
+    EXPECT_TRUE(m == Money{ 105 });
+
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::add), 10u);
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::sub), 1u);
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::mul), 1u);
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::div), 1u);
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::equal), 1u);
+    EXPECT_EQ(calls_of("Money", dmopex::profile_op::add), 1u);
+    EXPECT_EQ(calls_of("Money", dmopex::profile_op::equal), 1u);
+
+    // 最常调用的排在最前, 每 DMOPEX_PROFILE_CYCLES 次调用计时一次
+    std::vector<dmopex::profile_entry> entries = dmopex::profile_snapshot();
+    ASSERT_FALSE(entries.empty());
+    EXPECT_EQ(entries[0].type, "Vector3D");
+    EXPECT_EQ(entries[0].op, dmopex::profile_op::add);
+#if defined(DMOPEX_PROFILE_CYCLES)
+    EXPECT_EQ(entries[0].sampled, (10u + DMOPEX_PROFILE_CYCLES - 1) / DMOPEX_PROFILE_CYCLES);
+    const char* first_line = "Vector3D + 10 ";
+#else
+    EXPECT_EQ(entries[0].sampled, 0u);
+    const char* first_line = "Vector3D + 10\n";
+#endif
+
+    std::ostringstream os;
+    dmopex::profile_dump(os);
+    EXPECT_EQ(os.str().rfind(first_line, 0), 0u);
+}
+
+TEST(ProfileTest, Threads) {
+    dmopex::profile_reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            Vector3D v{ 0, 0, 0 };
+            for (int i = 0; i < 1000; ++i) {
+                v = v + Vector3D{ 1, 1, 1 };
+            }
+            EXPECT_EQ(v.x, 1000);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // 线程退出后计数保留
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::add), 4000u);
+
+    dmopex::profile_reset();
+    EXPECT_EQ(calls_of("Vector3D", dmopex::profile_op::add), 0u);
+}
@@ -0,0 +1,148 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_project.h"
+#include "dmopex_hash.h"
+#include "gtest.h"
+
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <unordered_set>
+
+// 10 个成员的实体, 热字段只有 x, y
+struct Entity {
+    double x, y;
+    double vx, vy;
+    int hp, mp;
+    unsigned id, team;
+    float scale, angle;
+
+    DEFINE_STRUCT_OPERATORS(Entity, x, y, vx, vy, hp, mp, id, team, scale, angle)
+};
+
+// 非侵入式, 饱和策略
+struct Stats {
+    std::uint8_t hits, misses;
+    int total;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE_EX(Stats, dmopex::saturate_policy, hits, misses, total)
+
+struct Counters {
+    int m1, m2, m3, m4, m5, m6, m7, m8;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Counters, m1, m2, m3, m4, m5, m6, m7, m8)
+
+static Entity make_entity(double x, double y, unsigned id) {
+    Entity e{};
+    e.x = x;
+    e.y = y;
+    e.vx = 0.5;
+    e.vy = -0.5;
+    e.hp = 100;
+    e.id = id;
+    return e;
+}
+
+TEST(ProjectTest, CompoundArithmeticTouchesOnlyProjectedMembers) {
+    Entity e = make_entity(1.0, 2.0, 7);
+    Entity step = make_entity(0.5, 0.25, 99);
+    step.hp = 1000;
+
+    dmopex::project<&Entity::x, &Entity::y>(e) += dmopex::project<&Entity::x, &Entity::y>(step);
+    EXPECT_DOUBLE_EQ(e.x, 1.5);
+    EXPECT_DOUBLE_EQ(e.y, 2.25);
+    EXPECT_EQ(e.hp, 100);
+    EXPECT_EQ(e.id, 7u);
+
+    dmopex::project<&Entity::hp>(e) -= step;
+    EXPECT_EQ(e.hp, -900);
+    EXPECT_DOUBLE_EQ(e.x, 1.5);
+
+    dmopex::project<&Entity::x, &Entity::y>(e) *= make_entity(2.0, 4.0, 0);
+    EXPECT_DOUBLE_EQ(e.x, 3.0);
+    EXPECT_DOUBLE_EQ(e.y, 9.0);
+
+    dmopex::project<&Entity::y>(e) /= make_entity(0.0, 3.0, 0);
+    EXPECT_DOUBLE_EQ(e.y, 3.0);
+}
+
+TEST(ProjectTest, PolicyIsKept) {
+    Stats s{ 250, 3, 10 };
+    dmopex::project<&Stats::hits, &Stats::total>(s) += Stats{ 10, 200, 5 };
+    EXPECT_EQ(s.hits, 255);
+    EXPECT_EQ(s.misses, 3);
+    EXPECT_EQ(s.total, 15);
+}
+
+TEST(ProjectTest, Comparison) {
+    Counters a{ 1, 2, 3, 4, 5, 6, 7, 8 };
+    Counters b{ 1, 0, 3, 0, 0, 0, 0, 0 };
+    EXPECT_FALSE(a == b);
+    EXPECT_TRUE((dmopex::project<&Counters::m1, &Counters::m3>(a) == dmopex::project<&Counters::m1, &Counters::m3>(b)));
+    EXPECT_TRUE((dmopex::project<&Counters::m2>(a) != dmopex::project<&Counters::m2>(b)));
+    EXPECT_TRUE((dmopex::project<&Counters::m2>(b) < dmopex::project<&Counters::m2>(a)));
+
+    // Projection order decides the ordering
+    Counters c{ 0, 9, 0, 0, 0, 0, 0, 0 };
+    EXPECT_TRUE((dmopex::project<&Counters::m1, &Counters::m2>(c) < dmopex::project<&Counters::m1, &Counters::m2>(a)));
+    EXPECT_TRUE((dmopex::project<&Counters::m2, &Counters::m1>(a) < dmopex::project<&Counters::m2, &Counters::m1>(c)));
+
+    const Counters& ca = a;
+    EXPECT_TRUE((dmopex::project<&Counters::m8>(ca) == dmopex::project<&Counters::m8>(a)));
+    EXPECT_EQ((dmopex::project<&Counters::m8, &Counters::m1>(ca).get<0>()), 8);
+}
+
+TEST(ProjectTest, Hash) {
+    Entity a = make_entity(1.0, 2.0, 7);
+    Entity b = make_entity(1.0, 2.0, 8);
+    EXPECT_NE(dmopex::hash(a), dmopex::hash(b));
+    EXPECT_EQ(dmopex::hash(dmopex::project<&Entity::x, &Entity::y>(a)), dmopex::hash(dmopex::project<&Entity::x, &Entity::y>(b)));
+    EXPECT_NE(dmopex::hash(dmopex::project<&Entity::id>(a)), dmopex::hash(dmopex::project<&Entity::id>(b)));
+
+    std::unordered_set<Entity, dmopex::projected_hash<&Entity::id>, dmopex::projected_equal<&Entity::id>> by_id;
+    by_id.insert(a);
+    by_id.insert(b);
+    by_id.insert(make_entity(5.0, 5.0, 7));
+    EXPECT_EQ(by_id.size(), 2u);
+
+    std::set<Entity, dmopex::projected_less<&Entity::team, &Entity::id>> ordered{ b, a };
+    EXPECT_EQ(ordered.begin()->id, 7u);
+
+    std::unordered_set<Counters, dmopex::hasher> all;
+    all.insert(Counters{ 1, 2, 3, 4, 5, 6, 7, 8 });
+    all.insert(Counters{ 1, 2, 3, 4, 5, 6, 7, 8 });
+    EXPECT_EQ(all.size(), 1u);
+}
+
+TEST(ProjectTest, Batch) {
+    std::vector<Entity> positions;
+    std::vector<Entity> velocities;
+    for (unsigned i = 0; i < 100; ++i) {
+        positions.push_back(make_entity(i, 2.0 * i, i));
+        Entity v = make_entity(1.0, -1.0, 1000);
+        v.hp = -1;
+        velocities.push_back(v);
+    }
+
+    dmopex::batch_add<&Entity::x, &Entity::y>(positions, velocities, positions);
+    for (unsigned i = 0; i < 100; ++i) {
+        EXPECT_DOUBLE_EQ(positions[i].x, i + 1.0);
+        EXPECT_DOUBLE_EQ(positions[i].y, 2.0 * i - 1.0);
+        EXPECT_EQ(positions[i].hp, 100);
+        EXPECT_EQ(positions[i].id, i);
+    }
+
+    std::vector<Stats> a{ { 200, 0, 1 }, { 1, 1, 1 } };
+    std::vector<Stats> b{ { 100, 9, 2 }, { 2, 9, 2 } };
+    std::vector<Stats> out{ { 0, 42, 0 }, { 0, 42, 0 } };
+    dmopex::batch_mul<&Stats::hits>(a, b, out);
+    EXPECT_EQ(out[0].hits, 255);
+    EXPECT_EQ(out[1].hits, 2);
+    EXPECT_EQ(out[0].misses, 42);
+    EXPECT_EQ(out[1].total, 0);
+
+    dmopex::batch_sub<&Stats::total>(a, b, out);
+    EXPECT_EQ(out[0].total, -1);
+    dmopex::batch_div<&Stats::total>(b, a, out);
+    EXPECT_EQ(out[1].total, 2);
+}
@@ -0,0 +1,131 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_reduce.h"
+#include "gtest.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+struct Vector2D {
+    float x, y;
+
+    DEFINE_STRUCT_OPERATORS(Vector2D, x, y)
+};
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 非侵入式四元数
+struct Quat {
+    float x, y, z, w;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Quat, x, y, z, w)
+
+// 小整数成员, 求和按 int 计算
+struct Pixel {
+    std::uint8_t r, g, b;
+
+    DEFINE_STRUCT_OPERATORS(Pixel, r, g, b)
+};
+
+// 嵌套成员与数组成员, 成员类型不同
+struct Body {
+    Vector3D position;
+    int mass;
+    double extents[2];
+
+    DEFINE_STRUCT_OPERATORS(Body, position, mass, extents)
+};
+
+TEST(ReduceTest, Members) {
+    Vector3D v{ 3.0f, -4.0f, 12.0f };
+    EXPECT_EQ(dmopex::sum_members(v), 11.0f);
+    EXPECT_EQ(dmopex::min_member(v), -4.0f);
+    EXPECT_EQ(dmopex::max_member(v), 12.0f);
+    EXPECT_EQ(dmopex::length_squared(v), 169.0f);
+    EXPECT_EQ(dmopex::length(v), 13.0f);
+
+    Pixel p{ 200, 100, 250 };
+    static_assert(std::is_same_v<decltype(dmopex::sum_members(p)), int>, "small integers are summed as int");
+    EXPECT_EQ(dmopex::sum_members(p), 550);
+    EXPECT_EQ(dmopex::dot(p, p), 40000 + 10000 + 62500);
+    EXPECT_EQ(dmopex::min_member(p), 100);
+    EXPECT_EQ(dmopex::distance_squared(Pixel{ 0, 10, 0 }, Pixel{ 3, 6, 0 }), 25);
+
+    Body body{ { 1.0f, 2.0f, 3.0f }, 4, { 0.5, -8.0 } };
+    static_assert(std::is_same_v<decltype(dmopex::sum_members(body)), double>, "common type of all leaves");
+    EXPECT_EQ(dmopex::sum_members(body), 2.5);
+    EXPECT_EQ(dmopex::min_member(body), -8.0);
+    EXPECT_EQ(dmopex::max_member(body), 4.0);
+    EXPECT_EQ(dmopex::dot(body, body), 1 + 4 + 9 + 16 + 0.25 + 64);
+
+    std::array<int, 3> arr{ 1, 2, 3 };
+    EXPECT_EQ(dmopex::dot(arr, arr), 14);
+    EXPECT_EQ(dmopex::max_member(arr), 3);
+    EXPECT_EQ(dmopex::distance(2.0, 5.0), 3.0);
+}
+
+TEST(ReduceTest, Dot) {
+    Vector3D a{ 1.0f, 2.0f, 3.0f };
+    Vector3D b{ 4.0f, -5.0f, 6.0f };
+    EXPECT_EQ(dmopex::dot(a, b), 12.0f);
+    EXPECT_EQ(dmopex::distance_squared(a, b), 9.0f + 49.0f + 9.0f);
+    EXPECT_EQ(dmopex::distance(Vector2D{ 0, 0 }, Vector2D{ 3, 4 }), 5.0f);
+    EXPECT_EQ(dmopex::dot(Quat{ 0, 0, 0, 1 }, Quat{ 0.5f, 0.5f, 0.5f, 0.5f }), 0.5f);
+}
+
+template<typename T, typename Make>
+static void expect_batch_matches_scalar(Make make) {
+    using R = dmopex::reduce_detail::sum_t<T>;
+    for (std::size_t n : { 0u, 1u, 3u, 4u, 5u, 16u, 101u }) {
+        std::vector<T> a, b;
+        for (std::size_t i = 0; i < n; ++i) {
+            a.push_back(make(static_cast<int>(i)));
+            b.push_back(make(static_cast<int>(i * 7 % 13) - 6));
+        }
+        std::vector<R> dots(n), lengths(n), distances(n);
+        dmopex::batch_dot<T>(a, b, dots);
+        dmopex::batch_length_squared<T>(a, lengths);
+        dmopex::batch_distance_squared<T>(a, b, distances);
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(dots[i], dmopex::dot(a[i], b[i]));
+            EXPECT_EQ(lengths[i], dmopex::length_squared(a[i]));
+            EXPECT_EQ(distances[i], dmopex::distance_squared(a[i], b[i]));
+        }
+    }
+}
+
+TEST(ReduceTest, BatchMatchesScalar) {
+    static_assert(dmopex::reduce_detail::float_leaves<Vector3D>::value == 3, "Vector3D is reduced four at a time");
+    static_assert(dmopex::reduce_detail::float_leaves<Body>::value == 0, "mixed leaves go element by element");
+
+    expect_batch_matches_scalar<float>([](int i) { return i * 0.5f; });
+    expect_batch_matches_scalar<Vector2D>([](int i) { return Vector2D{ float(i), -2.0f * i }; });
+    expect_batch_matches_scalar<Vector3D>([](int i) { return Vector3D{ float(i), 0.25f * i, float(i % 5) }; });
+    expect_batch_matches_scalar<Quat>([](int i) { return Quat{ float(i), 1.0f, -0.5f * i, float(i % 3) }; });
+    expect_batch_matches_scalar<Pixel>([](int i) { return Pixel{ std::uint8_t(i * 3), std::uint8_t(i), 255 }; });
+    expect_batch_matches_scalar<Body>([](int i) { return Body{ { float(i), 1.0f, 2.0f }, i, { 0.5 * i, 1.0 } }; });
+}
+
+TEST(ReduceTest, DistanceCheck) {
+    std::vector<Vector3D> units(1000);
+    for (std::size_t i = 0; i < units.size(); ++i) {
+        units[i] = Vector3D{ float(i % 40), float(i / 40), 0.0f };
+    }
+    std::vector<Vector3D> center(units.size(), Vector3D{ 20.0f, 12.0f, 0.0f });
+    std::vector<float> d2(units.size());
+    dmopex::batch_distance_squared<Vector3D>(units, center, d2);
+
+    std::size_t in_range = 0;
+    for (std::size_t i = 0; i < units.size(); ++i) {
+        in_range += d2[i] <= 25.0f;
+        EXPECT_EQ(d2[i] <= 25.0f, std::hypot(units[i].x - 20.0f, units[i].y - 12.0f) <= 5.0f);
+    }
+    // 半径 5 内的整数格点
+    EXPECT_EQ(in_range, 81u);
+}
@@ -0,0 +1,84 @@
+﻿#include "dmopex.h"
+#include "dmopex_seqlock.h"
+#include "gtest.h"
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+struct Vector3D {
+    double x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 相机: 多个缓存字, 撕裂读取时成员会不一致
+struct Camera {
+    Vector3D position;
+    Vector3D target;
+    float fov, aspect;
+    std::uint32_t frame;
+
+    DEFINE_STRUCT_OPERATORS(Camera, position, target, fov, aspect, frame)
+};
+
+static Camera make_camera(std::uint32_t frame) {
+    double v = static_cast<double>(frame);
+    return Camera{ { v, v, v }, { -v, -v, -v }, static_cast<float>(frame % 1000), static_cast<float>(frame % 1000), frame };
+}
+
+static bool consistent(const Camera& c) {
+    return c == make_camera(c.frame);
+}
+
+TEST(SeqlockTest, StoreLoad) {
+    dmopex::seqlock<Vector3D> cell(Vector3D{ 1.0, 2.0, 3.0 });
+    EXPECT_EQ(cell.version(), 0u);
+    EXPECT_TRUE(cell.load() == (Vector3D{ 1.0, 2.0, 3.0 }));
+
+    cell.store(Vector3D{ 4.0, 5.0, 6.0 });
+    EXPECT_EQ(cell.version(), 1u);
+
+    Vector3D out{};
+    ASSERT_TRUE(cell.try_load(out));
+    EXPECT_TRUE(out == (Vector3D{ 4.0, 5.0, 6.0 }));
+}
+
+TEST(SeqlockTest, ReadersNeverSeeTornValues) {
+    const int readers = 4;
+    const int reads_per_reader = 200000;
+
+    dmopex::seqlock<Camera> cell(make_camera(0));
+    std::atomic<int> finished{ 0 };
+    std::atomic<int> torn{ 0 };
+    std::atomic<int> backwards{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            std::uint32_t last = 0;
+            for (int i = 0; i < reads_per_reader; ++i) {
+                Camera c = cell.load();
+                torn += consistent(c) ? 0 : 1;
+                backwards += c.frame < last ? 1 : 0;
+                last = c.frame;
+            }
+            ++finished;
+        });
+    }
+
+    // 写线程持续发布, 直到所有读线程完成
+    std::uint32_t frame = 0;
+    while (finished.load() < readers) {
+        cell.store(make_camera(++frame));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(backwards.load(), 0);
+    EXPECT_EQ(cell.version(), frame);
+    EXPECT_TRUE(cell.load() == make_camera(frame));
+}
@@ -0,0 +1,100 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_sharded.h"
+#include "gtest.h"
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+// 请求遥测计数
+struct Telemetry {
+    std::int64_t requests;
+    std::int64_t bytes;
+    std::int32_t errors;
+    std::int32_t retries;
+    double latency_ms;
+
+    DEFINE_STRUCT_OPERATORS(Telemetry, requests, bytes, errors, retries, latency_ms)
+};
+
+// 非侵入式, 64 个计数器
+struct Counters64 {
+    int c[64];
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Counters64, c)
+
+template<typename F>
+static void run_threads(int count, F f) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < count; ++t) {
+        threads.emplace_back(f, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(ShardedTest, CollectMergesAllThreads) {
+    const int threads = 8;
+    const int rounds = 10000;
+
+    dmopex::sharded<Telemetry> telemetry;
+    run_threads(threads, [&](int t) {
+        for (int i = 0; i < rounds; ++i) {
+            telemetry += Telemetry{ 1, 100, i % 10 == 0 ? 1 : 0, t, 0.5 };
+        }
+    });
+    telemetry -= Telemetry{ 0, 0, 0, 0, 0.5 };
+
+    Telemetry total = telemetry.collect();
+    EXPECT_EQ(total.requests, threads * rounds);
+    EXPECT_EQ(total.bytes, 100LL * threads * rounds);
+    EXPECT_EQ(total.errors, threads * rounds / 10);
+    EXPECT_EQ(total.retries, rounds * (0 + 1 + 2 + 3 + 4 + 5 + 6 + 7));
+    EXPECT_DOUBLE_EQ(total.latency_ms, 0.5 * threads * rounds - 0.5);
+}
+
+TEST(ShardedTest, ExitedThreadsStayInTotal) {
+    dmopex::sharded<Counters64> counters;
+    Counters64 one{};
+    for (int& c : one.c) {
+        c = 1;
+    }
+
+    // 线程依次退出, 槽位被复用
+    for (int round = 0; round < 50; ++round) {
+        std::thread([&] { counters += one; }).join();
+    }
+    counters.update([](Counters64& local) { local.c[63] += 10; });
+
+    Counters64 total = counters.collect();
+    EXPECT_EQ(total.c[0], 50);
+    EXPECT_EQ(total.c[62], 50);
+    EXPECT_EQ(total.c[63], 60);
+}
+
+TEST(ShardedTest, CollectWhileUpdating) {
+    dmopex::sharded<Telemetry> telemetry;
+    std::atomic<bool> done{ false };
+
+    std::thread reader([&] {
+        std::int64_t last = 0;
+        while (!done.load()) {
+            Telemetry t = telemetry.collect();
+            EXPECT_GE(t.requests, last);
+            EXPECT_EQ(t.bytes % 100, 0);
+            last = t.requests;
+        }
+    });
+    run_threads(4, [&](int) {
+        for (int i = 0; i < 20000; ++i) {
+            telemetry += Telemetry{ 1, 100, 0, 0, 0.0 };
+        }
+    });
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(telemetry.collect().requests, 4 * 20000);
+}
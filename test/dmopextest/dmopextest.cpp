@@ -1,6 +1,9 @@
 ﻿#include "dmopex.h"
 #include "gtest.h" 
 
+#include <sstream>
+#include <utility>
+
 class env_dmopex
 {
 public:
@@ -256,4 +259,156 @@ TEST_F(DmOpExTest, readme)
     Color c_test3{ 1,2,3,4 };
     EXPECT_EQ(c_test1, c_test2);
     EXPECT_NE(c_test1, c_test3);
-}
\ No newline at end of file
+}
+// 字段元数据测试
+static_assert(dmopex::is_reflected_v<Point2D>, "Point2D should be reflected");
+static_assert(!dmopex::is_reflected_v<int>, "int should not be reflected");
+static_assert(dmopex::fields<Vector3D>::size == 3, "Vector3D has 3 members");
+static_assert(dmopex::fields<Color>::names[3] == "a", "Color member 3 is a");
+static_assert(dmopex::fields<Color>::index_of("g") == 1, "Color::g is member 1");
+static_assert(std::is_same_v<dmopex::fields<Point2D>::type<1>, double>, "Point2D::y is double");
+
+TEST_F(DmOpExTest, FieldMetadata)
+{
+    using point_fields = dmopex::fields<Point2D>;
+    EXPECT_EQ(point_fields::size, 2u);
+    EXPECT_EQ(point_fields::names[0], "x");
+    EXPECT_EQ(point_fields::names[1], "y");
+    EXPECT_EQ(point_fields::index_of("z"), point_fields::size);
+
+    Point2D p{ 1.5, 2.5 };
+    dmopex::get<1>(p) = 4.0;
+    EXPECT_EQ(p, Point2D(1.5, 4.0));
+
+    std::string names;
+    double total = 0.0;
+    dmopex::for_each_field(v1, [&](std::string_view name, double value) {
+        names += name;
+        total += value;
+    });
+    EXPECT_EQ(names, "xyz");
+    EXPECT_EQ(total, 6.0);
+}
+
+// 嵌套结构体: Scale 只注册了字段元数据, 没有自己的运算符
+struct Scale {
+    float sx, sy;
+};
+template<>
+struct struct_access_traits<Scale> {
+    DEFINE_STRUCT_FIELDS(Scale, sx, sy)
+};
+
+struct Transform {
+    Vector3D pos;
+    Scale scale;
+    Color tint;
+
+    DEFINE_STRUCT_OPERATORS(Transform, pos, scale, tint)
+};
+
+static_assert(dmopex::leaf_count_v<Transform> == 9, "Transform flattens to 3 + 2 + 4 leaves");
+static_assert(std::is_same_v<std::tuple_element_t<3, dmopex::leaf_fields_t<Transform>>,
+    dmopex::field_path<&Transform::scale, &Scale::sx>>, "leaf 3 is scale.sx");
+
+TEST_F(DmOpExTest, NestedStructs)
+{
+    Transform a{ Vector3D(1.0, 2.0, 3.0), Scale{ 1.0f, 2.0f }, Color(10, 20, 30, 40) };
+    Transform b{ Vector3D(0.5, 0.5, 0.5), Scale{ 2.0f, 0.5f }, Color(1, 2, 3, 4) };
+
+    Transform sum = a + b;
+    EXPECT_EQ(sum.pos, Vector3D(1.5, 2.5, 3.5));
+    EXPECT_EQ(sum.scale.sx, 3.0f);
+    EXPECT_EQ(sum.scale.sy, 2.5f);
+    EXPECT_EQ(sum.tint, Color(11, 22, 33, 44));
+
+    Transform product = a * b;
+    EXPECT_EQ(product.scale.sy, 1.0f);
+    EXPECT_EQ(product.tint, Color(10, 40, 90, 160));
+    EXPECT_EQ(product - a * b, (Transform{ Vector3D(0, 0, 0), Scale{ 0, 0 }, Color(0, 0, 0, 0) }));
+
+    EXPECT_EQ(a, a);
+    EXPECT_NE(a, b);
+    Transform c = a;
+    c.scale.sy = 7.0f;
+    EXPECT_NE(a, c);
+
+    c -= a;
+    EXPECT_EQ(c.scale.sy, 5.0f);
+
+    std::ostringstream oss;
+    oss << a;
+    EXPECT_EQ(oss.str(), "((1, 2, 3), (1, 2), (10, 20, 30, 40))");
+
+    EXPECT_EQ((std::tuple_element_t<8, dmopex::leaf_fields_t<Transform>>::get(a)), 40);
+}
+
+// 聚合体, 运算符可在编译期求值
+struct Rgb {
+    int r, g, b;
+
+    DEFINE_STRUCT_OPERATORS(Rgb, r, g, b)
+};
+
+// 编译期常量表
+constexpr Rgb kRed{ 255, 0, 0 };
+constexpr Rgb kGreen{ 0, 255, 0 };
+constexpr Rgb kPalette[] = { kRed, kGreen, kRed + kGreen, (kRed + kGreen) / Rgb{ 2, 2, 2 }, kRed * Rgb{ 0, 1, 1 } - kGreen };
+
+constexpr Rgb accumulate(int n) {
+    Rgb c{ 0, 0, 0 };
+    for (int i = 0; i < n; ++i) {
+        c += Rgb{ 1, 2, 3 };
+    }
+    c *= Rgb{ 2, 2, 2 };
+    c -= Rgb{ 1, 1, 1 };
+    c /= Rgb{ 1, 3, 1 };
+    return c;
+}
+
+static_assert(kPalette[2] == Rgb{ 255, 255, 0 }, "constexpr operator+");
+static_assert(kPalette[3] == Rgb{ 127, 127, 0 }, "constexpr operator/");
+static_assert(kPalette[4] == Rgb{ 0, -255, 0 }, "constexpr operator* and operator-");
+static_assert(kPalette[0] != kPalette[1], "constexpr operator!=");
+static_assert(accumulate(4) == Rgb{ 7, 5, 23 }, "constexpr compound assignment");
+
+// 成员运算都不会抛出时, 运算符为 noexcept
+static_assert(noexcept(std::declval<const Rgb&>() + std::declval<const Rgb&>()), "int members do not throw");
+static_assert(noexcept(std::declval<Rgb&>() /= std::declval<const Rgb&>()), "wrap policy does not throw");
+static_assert(noexcept(std::declval<const Rgb&>() == std::declval<const Rgb&>()), "comparison does not throw");
+static_assert(noexcept(std::declval<const Transform&>() * std::declval<const Transform&>()), "nested members do not throw");
+static_assert(noexcept(std::declval<const Transform&>() != std::declval<const Transform&>()), "nested comparison does not throw");
+
+// 成员类型自带的运算符可能抛出时, 运算符不是 noexcept
+struct Amount {
+    long cents;
+
+    Amount operator+(const Amount& other) const { return Amount{ cents + other.cents }; }
+    Amount operator-(const Amount& other) const { return Amount{ cents - other.cents }; }
+    Amount operator*(const Amount& other) const { return Amount{ cents * other.cents }; }
+    Amount operator/(const Amount& other) const { return Amount{ cents / other.cents }; }
+    bool operator==(const Amount& other) const noexcept { return cents == other.cents; }
+
+    friend std::ostream& operator<<(std::ostream& os, const Amount& amount) { return os << amount.cents; }
+};
+
+struct Ledger {
+    Amount total;
+    int entries;
+
+    DEFINE_STRUCT_OPERATORS(Ledger, total, entries)
+};
+
+static_assert(!noexcept(std::declval<const Ledger&>() + std::declval<const Ledger&>()), "Amount::operator+ may throw");
+static_assert(noexcept(std::declval<const Ledger&>() == std::declval<const Ledger&>()), "Amount::operator== is noexcept");
+
+TEST_F(DmOpExTest, ConstexprOperators)
+{
+    EXPECT_EQ(kPalette[2], Rgb({ 255, 255, 0 }));
+    EXPECT_EQ(accumulate(4), Rgb({ 7, 5, 23 }));
+
+    Ledger a{ Amount{ 150 }, 1 };
+    Ledger sum = a + a;
+    EXPECT_EQ(sum.total.cents, 300);
+    EXPECT_EQ(sum.entries, 2);
+}
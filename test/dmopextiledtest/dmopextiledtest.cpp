@@ -0,0 +1,145 @@
+﻿#include "dmopex.h"
+#include "dmopex_color.h"
+#include "dmopex_tiled.h"
+#include "gtest.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 成员类型不同, 逐叶子计算
+struct Body {
+    Vector3D position;
+    int mass;
+    double extents[2];
+
+    DEFINE_STRUCT_OPERATORS(Body, position, mass, extents)
+};
+
+// 不可平凡复制, 非临时存储不适用, 按普通方式写出
+struct Tagged {
+    std::string name;
+    int value;
+
+    Tagged operator+(const Tagged& other) const { return Tagged{ name + other.name, value + other.value }; }
+};
+
+// 不是块大小整数倍的元素个数
+constexpr std::size_t kCount = 3001;
+
+std::vector<dmopex::tile_options> all_options() {
+    std::vector<dmopex::tile_options> result;
+    for (std::size_t distance : { 0, 64, 1000, 100000 }) {
+        for (bool stream : { false, true }) {
+            dmopex::tile_options options;
+            options.prefetch_bytes = distance;
+            options.stream_stores = stream;
+            result.push_back(options);
+        }
+    }
+    return result;
+}
+
+TEST(TiledTest, MatchesBatch) {
+    std::vector<Vector3D> a(kCount), b(kCount), expected(kCount);
+    std::vector<dmopex::rgba8> x(kCount), y(kCount), expected_rgba(kCount);
+    std::vector<Body> p(kCount), q(kCount), expected_body(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float v = static_cast<float>(i);
+        a[i] = Vector3D{ v, -v, 0.5f * v };
+        b[i] = Vector3D{ 1, 2, 3 };
+        x[i] = dmopex::rgba8{ static_cast<std::uint8_t>(i), 200, 10, 255 };
+        y[i] = dmopex::rgba8{ 100, 100, static_cast<std::uint8_t>(i * 7), 1 };
+        p[i] = Body{ a[i], static_cast<int>(i), { v, 2 * v } };
+        q[i] = Body{ b[i], 3, { 1, 2 } };
+    }
+    dmopex::batch_mul<Vector3D>(a, b, expected);
+    dmopex::batch_add<dmopex::rgba8>(x, y, expected_rgba);
+    dmopex::batch_sub<Body>(p, q, expected_body);
+
+    for (const dmopex::tile_options& options : all_options()) {
+        std::vector<Vector3D> out(kCount);
+        dmopex::batch_mul<Vector3D>(a, b, out, options);
+        EXPECT_TRUE(out == expected);
+
+        // 输出不是按 16 字节对齐时, 首尾部分按普通方式写出
+        std::vector<Vector3D> shifted(kCount + 1);
+        dmopex::batch_mul<Vector3D>(a, b, dmopex::span<Vector3D>(shifted).subspan(1), options);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), shifted.begin() + 1));
+
+        std::vector<dmopex::rgba8> out_rgba(kCount);
+        dmopex::batch_add<dmopex::rgba8>(x, y, out_rgba, options);
+        EXPECT_TRUE(out_rgba == expected_rgba);
+
+        std::vector<Body> out_body(kCount);
+        dmopex::batch_sub<Body>(p, q, out_body, options);
+        EXPECT_TRUE(out_body == expected_body);
+
+        // 输出可以就是输入
+        std::vector<Vector3D> in_place = a;
+        dmopex::batch_mul<Vector3D>(in_place, b, in_place, options);
+        EXPECT_TRUE(in_place == expected);
+    }
+
+    dmopex::tile_options options;
+    options.stream_stores = true;
+    std::vector<Tagged> left{ { "a", 1 }, { "b", 2 } }, right{ { "c", 3 }, { "d", 4 } }, joined(2);
+    dmopex::batch_add<Tagged>(left, right, joined, options);
+    EXPECT_EQ(joined[1].name, "bd");
+    EXPECT_EQ(joined[1].value, 6);
+}
+
+TEST(TiledTest, ForEachTile) {
+    dmopex::tile_options options;
+    options.tile_bytes = 1200;
+
+    // 每块 100 个 Vector3D, 最后一块不满
+    std::vector<std::pair<std::size_t, std::size_t>> tiles;
+    dmopex::for_each_tile<Vector3D>(250, options, [&](std::size_t first, std::size_t count) {
+        tiles.emplace_back(first, count);
+    });
+    ASSERT_EQ(tiles.size(), 3u);
+    EXPECT_EQ(tiles[0], std::make_pair(std::size_t{ 0 }, std::size_t{ 100 }));
+    EXPECT_EQ(tiles[2], std::make_pair(std::size_t{ 200 }, std::size_t{ 50 }));
+
+    // 小于一个元素的分块仍然前进
+    options.tile_bytes = 1;
+    std::size_t calls = 0;
+    dmopex::for_each_tile<Vector3D>(5, options, [&](std::size_t, std::size_t count) {
+        EXPECT_EQ(count, 1u);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 5u);
+
+    dmopex::for_each_tile<Vector3D>(0, options, [&](std::size_t, std::size_t) { ADD_FAILURE(); });
+}
+
+TEST(TiledTest, ChainPerTile) {
+    std::vector<Vector3D> a(kCount), b(kCount), s(kCount), c(kCount), out(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float v = static_cast<float>(i);
+        a[i] = Vector3D{ v, 1, -v };
+        b[i] = Vector3D{ 2, v, 3 };
+        s[i] = Vector3D{ 0.5f, 2, -1 };
+    }
+
+    // 每个分块内依次执行两次批量运算, 中间数组留在缓存中
+    dmopex::tile_options options;
+    options.tile_bytes = 4096;
+    options.stream_stores = true;
+    using cspan = dmopex::span<const Vector3D>;
+    using mspan = dmopex::span<Vector3D>;
+    dmopex::for_each_tile<Vector3D>(kCount, options, [&](std::size_t i, std::size_t n) {
+        dmopex::batch_add<Vector3D>(cspan(a).subspan(i, n), cspan(b).subspan(i, n), mspan(c).subspan(i, n));
+        dmopex::batch_mul<Vector3D>(cspan(c).subspan(i, n), cspan(s).subspan(i, n), mspan(out).subspan(i, n), options);
+    });
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_TRUE(out[i] == (a[i] + b[i]) * s[i]);
+    }
+}
@@ -0,0 +1,156 @@
+﻿#include "dmopex.h"
+#include "dmopex_non_intrusive.h"
+#include "dmopex_transpose.h"
+#include "gtest.h"
+
+#include <vector>
+#include <cstdint>
+
+struct Vector3D {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Vector3D, x, y, z)
+};
+
+// 8 字节成员
+struct Vector2D {
+    double x, y;
+
+    DEFINE_STRUCT_OPERATORS(Vector2D, x, y)
+};
+
+// 非侵入式四元数
+struct Quat {
+    float x, y, z, w;
+};
+DEFINE_STRUCT_OPERATORS_NON_INTRUSIVE(Quat, x, y, z, w)
+
+// 整数成员, 按位搬运
+struct Cell {
+    std::int32_t row, col;
+
+    DEFINE_STRUCT_OPERATORS(Cell, row, col)
+};
+
+// 宏中的成员顺序与内存顺序不同
+struct Reversed {
+    float x, y, z;
+
+    DEFINE_STRUCT_OPERATORS(Reversed, z, y, x)
+};
+
+// 嵌套成员、数组成员与填充, 逐叶子复制
+struct Particle {
+    Vector3D position;
+    std::uint8_t kind;
+    double weights[2];
+
+    DEFINE_STRUCT_OPERATORS(Particle, position, kind, weights)
+};
+
+// 19 个元素: SIMD 块之后还有尾部
+constexpr std::size_t kCount = 19;
+
+TEST(TransposeTest, UniformLeaves) {
+    std::vector<Vector3D> points(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float f = static_cast<float>(i);
+        points[i] = Vector3D{ f, f * 10.0f, -f };
+    }
+    std::vector<float> xs(kCount), ys(kCount), zs(kCount);
+    dmopex::aos_to_soa<Vector3D>(points, { xs.data(), ys.data(), zs.data() });
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(xs[i], points[i].x);
+        EXPECT_EQ(ys[i], points[i].y);
+        EXPECT_EQ(zs[i], points[i].z);
+    }
+
+    std::vector<Vector3D> back(kCount);
+    dmopex::soa_to_aos<Vector3D>({ xs.data(), ys.data(), zs.data() }, back);
+    EXPECT_TRUE(back == points);
+
+    std::vector<Vector2D> pairs(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        pairs[i] = Vector2D{ i * 0.5, i * -2.0 };
+    }
+    std::vector<double> px(kCount), py(kCount);
+    dmopex::aos_to_soa<Vector2D>(pairs, { px.data(), py.data() });
+    EXPECT_EQ(px[7], 3.5);
+    EXPECT_EQ(py[18], -36.0);
+    std::vector<Vector2D> pairs_back(kCount);
+    dmopex::soa_to_aos<Vector2D>({ px.data(), py.data() }, pairs_back);
+    EXPECT_TRUE(pairs_back == pairs);
+
+    std::vector<Quat> quats(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float f = static_cast<float>(i);
+        quats[i] = Quat{ f, f + 0.25f, f + 0.5f, f + 0.75f };
+    }
+    std::vector<float> qx(kCount), qy(kCount), qz(kCount), qw(kCount);
+    dmopex::aos_to_soa<Quat>(quats, { qx.data(), qy.data(), qz.data(), qw.data() });
+    EXPECT_EQ(qw[13], 13.75f);
+    EXPECT_EQ(qy[2], 2.25f);
+    std::vector<Quat> quats_back(kCount);
+    dmopex::soa_to_aos<Quat>({ qx.data(), qy.data(), qz.data(), qw.data() }, quats_back);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_TRUE(quats_back[i] == quats[i]);
+    }
+
+    std::vector<Cell> cells(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        cells[i] = Cell{ static_cast<std::int32_t>(i), -static_cast<std::int32_t>(i) * 3 };
+    }
+    std::vector<std::int32_t> rows(kCount), cols(kCount);
+    dmopex::aos_to_soa<Cell>(cells, { rows.data(), cols.data() });
+    EXPECT_EQ(rows[11], 11);
+    EXPECT_EQ(cols[11], -33);
+    std::vector<Cell> cells_back(kCount);
+    dmopex::soa_to_aos<Cell>({ rows.data(), cols.data() }, cells_back);
+    EXPECT_TRUE(cells_back == cells);
+}
+
+TEST(TransposeTest, ColumnsFollowTheMacro) {
+    // 列的顺序是宏中的成员顺序, 不是内存顺序
+    static_assert(std::is_same_v<dmopex::columns_t<Reversed>, std::tuple<float*, float*, float*>>, "one column per leaf");
+    std::vector<Reversed> values(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float f = static_cast<float>(i);
+        values[i] = Reversed{ f, f + 100.0f, f + 200.0f };
+    }
+    std::vector<float> zs(kCount), ys(kCount), xs(kCount);
+    dmopex::aos_to_soa<Reversed>(values, { zs.data(), ys.data(), xs.data() });
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(xs[i], values[i].x);
+        EXPECT_EQ(ys[i], values[i].y);
+        EXPECT_EQ(zs[i], values[i].z);
+    }
+    std::vector<Reversed> back(kCount);
+    dmopex::soa_to_aos<Reversed>({ zs.data(), ys.data(), xs.data() }, back);
+    EXPECT_TRUE(back == values);
+}
+
+TEST(TransposeTest, MixedLeaves) {
+    static_assert(std::is_same_v<dmopex::columns_t<Particle>,
+        std::tuple<float*, float*, float*, std::uint8_t*, double(*)[2]>>, "nested members flattened, arrays as one column");
+
+    std::vector<Particle> particles(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        float f = static_cast<float>(i);
+        particles[i] = Particle{ { f, 2.0f * f, 3.0f * f }, static_cast<std::uint8_t>(i), { i * 0.5, i * 0.25 } };
+    }
+    std::vector<float> xs(kCount), ys(kCount), zs(kCount);
+    std::vector<std::uint8_t> kinds(kCount);
+    std::vector<double[2]> weights(kCount);
+    dmopex::aos_to_soa<Particle>(particles, { xs.data(), ys.data(), zs.data(), kinds.data(), weights.data() });
+    EXPECT_EQ(zs[5], 15.0f);
+    EXPECT_EQ(kinds[9], 9);
+    EXPECT_EQ(weights[6][0], 3.0);
+    EXPECT_EQ(weights[6][1], 1.5);
+
+    std::vector<Particle> back(kCount);
+    dmopex::soa_to_aos<Particle>({ xs.data(), ys.data(), zs.data(), kinds.data(), weights.data() }, back);
+    EXPECT_TRUE(back == particles);
+
+    // 空数组不做任何事
+    dmopex::aos_to_soa<Particle>(dmopex::span<const Particle>(), { nullptr, nullptr, nullptr, nullptr, nullptr });
+}
@@ -0,0 +1,51 @@
+﻿#include "dmopex.h"
+#include "dmopex_color.h"
+#include "dmopex_layout.h"
+
+#include <iostream>
+#include <cstdint>
+
+// Prints the layout report of every type registered with DMOPEX_LAYOUT_REPORT, the most
+// padding first, with the member order that minimizes the size. Include the headers of
+// your own reflected types here and register them next to the examples below.
+
+struct Point2D {
+    double x, y;
+
+    DEFINE_STRUCT_OPERATORS(Point2D, x, y)
+};
+
+struct Color {
+    int r, g, b, a;
+
+    DEFINE_STRUCT_OPERATORS(Color, r, g, b, a)
+};
+
+struct Transform {
+    Point2D position;
+    Color tint;
+
+    DEFINE_STRUCT_OPERATORS(Transform, position, tint)
+};
+
+struct Unit {
+    std::uint8_t team;
+    double health;
+    std::uint16_t level;
+    Point2D position;
+    bool alive;
+    float speed;
+
+    DEFINE_STRUCT_OPERATORS(Unit, team, health, level, position, alive, speed)
+};
+
+DMOPEX_LAYOUT_REPORT(dmopex::rgba8)
+DMOPEX_LAYOUT_REPORT(Point2D)
+DMOPEX_LAYOUT_REPORT(Color)
+DMOPEX_LAYOUT_REPORT(Transform)
+DMOPEX_LAYOUT_REPORT(Unit)
+
+int main() {
+    dmopex::print_layout_reports(std::cout);
+    return 0;
+}